@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lib/bst/BST.hpp"
+#include "lib/bst/ConcurrentBST.hpp"
+#include "lib/bst/FineGrainedBST.hpp"
+#include "lib/bst/ReadMostlyBST.hpp"
+#include "lib/bst/ShardedBST.hpp"
+
+namespace {
+
+constexpr uint32_t kKeyRange = 1 << 20;
+constexpr size_t kOperationsPerThread = 200000;
+
+class MutexBST {
+ public:
+  bool insert(uint32_t key) {
+    std::lock_guard lock(mutex_);
+    return bst_.insert(key).second;
+  }
+
+  size_t erase(uint32_t key) {
+    std::lock_guard lock(mutex_);
+    return bst_.erase(key);
+  }
+
+  bool contains(uint32_t key) const {
+    std::lock_guard lock(mutex_);
+    return bst_.contains(key);
+  }
+
+ private:
+  bialger::BST<uint32_t> bst_;
+  mutable std::mutex mutex_;
+};
+
+template<typename Set>
+void Fill(Set& set) {
+  std::mt19937 rng(42);
+
+  for (uint32_t i = 0; i < kKeyRange / 2; ++i) {
+    set.insert(rng() % kKeyRange);
+  }
+}
+
+template<typename Set>
+double RunBenchmark(Set& set, size_t threads_count, uint32_t read_percent) {
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < threads_count; ++i) {
+    threads.emplace_back([&set, i, read_percent] {
+      std::mt19937 rng(i + 1);
+      size_t found = 0;
+
+      for (size_t op = 0; op < kOperationsPerThread; ++op) {
+        uint32_t key = rng() % kKeyRange;
+        uint32_t kind = rng() % 100;
+
+        if (kind < read_percent) {
+          found += set.contains(key) ? 1 : 0;
+        } else if (kind % 2 == 0) {
+          set.insert(key);
+        } else {
+          set.erase(key);
+        }
+      }
+
+      volatile size_t sink = found;
+      (void) sink;
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(threads_count * kOperationsPerThread) / elapsed.count() / 1e6;
+}
+
+template<typename Set>
+void Report(const std::string& name, size_t max_threads, uint32_t read_percent) {
+  std::cout << name << ", " << read_percent << "% reads" << std::endl;
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    Set set;
+    Fill(set);
+    std::cout << std::setw(6) << threads << " threads: " << std::fixed << std::setprecision(2)
+              << RunBenchmark(set, threads, read_percent) << " Mops/s" << std::endl;
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t max_threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 64;
+
+  for (uint32_t read_percent : {100u, 95u, 50u}) {
+    Report<MutexBST>("BST + std::mutex", max_threads, read_percent);
+    Report<bialger::ConcurrentBST<uint32_t>>("ConcurrentBST", max_threads, read_percent);
+    Report<bialger::FineGrainedBST<uint32_t>>("FineGrainedBST", max_threads, read_percent);
+    Report<bialger::ReadMostlyBST<uint32_t>>("ReadMostlyBST", max_threads, read_percent);
+    Report<bialger::ShardedBST<uint32_t>>("ShardedBST", max_threads, read_percent);
+  }
+
+  return 0;
+}
@@ -1,25 +1,32 @@
 #ifndef LIB_BST_BST_HPP_
 #define LIB_BST_BST_HPP_
 
+#include <concepts>
 #include <limits>
+#include <span>
 
 #include "lib/tree/BinarySearchTree.hpp"
 #include "lib/tree/InOrder.hpp"
 #include "lib/tree/PreOrder.hpp"
 #include "lib/tree/PostOrder.hpp"
+#include "lib/tree/TreeNodeHandle.hpp"
 
 #include "BstIterator.hpp"
 #include "BstConcepts.hpp"
+#include "BstStreamWriter.hpp"
 
 namespace bialger {
 
-template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+template<Allocable T,
+    Comparator<T> Compare = std::less<>,
+    AllocatorType Allocator = std::allocator<T>,
+    AugmentationType<T> Augmentation = NoAugmentation>
 class BST {
   static_assert(std::is_same<typename std::remove_cv<T>::type, T>::value,
                 "bialger::BST must have a non-const, non-volatile value_type");
 
- private:
-  using TreeType = BinarySearchTree<T, const T*, Compare, Allocator>;
+ protected:
+  using TreeType = BinarySearchTree<T, EmptyValue, Compare, Allocator, Augmentation>;
   using Equals = TreeType::Equals;
   using NodeType = TreeType::NodeType;
   using DefaultTraversal = InOrder;
@@ -33,14 +40,23 @@ class BST {
   using const_pointer = const T*;
   using size_type = size_t;
   using difference_type = ptrdiff_t;
-  using iterator = BstIterator<T, Compare, Allocator>;
-  using const_iterator = BstIterator<T, Compare, Allocator>;
-  using reverse_iterator = BstIterator<T, Compare, Allocator, true>;
-  using const_reverse_iterator = BstIterator<T, Compare, Allocator, true>;
+  using iterator = BstIterator<T, Compare, Allocator, Augmentation>;
+  using const_iterator = BstIterator<T, Compare, Allocator, Augmentation>;
+  using reverse_iterator = BstIterator<T, Compare, Allocator, Augmentation, true>;
+  using const_reverse_iterator = BstIterator<T, Compare, Allocator, Augmentation, true>;
   using allocator_type = Allocator;
   using key_allocator = Allocator;
   using key_compare = Compare;
   using value_compare = Compare;
+  using aggregate_type = TreeType::aggregate_type;
+  using node_type = TreeNodeHandle<NodeType, typename TreeType::NodeAllocatorType>;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   using TreeInterface = TreeType::TreeInterface;
 
   BST() : tree_(),
@@ -111,24 +127,29 @@ class BST {
   template<InputIterator<T> InputIt>
   BST(InputIt first, InputIt last,
       const Compare& comp = Compare(),
-      const Allocator& alloc = Allocator()) : tree_(false, comp, alloc),
+      const Allocator& alloc = Allocator(),
+      size_t threads = std::thread::hardware_concurrency()) : tree_(false, comp, alloc),
                                               pre_order_(tree_),
                                               in_order_(tree_),
                                               post_order_(tree_),
                                               allocator_(alloc),
                                               key_compare_(comp),
                                               value_compare_(comp) {
-    for (; first != last; ++first) {
-      insert(*first);
+    if constexpr (std::forward_iterator<InputIt>) {
+      if (first != last && tree_.GetComparator()(*first, *first)) {
+        throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+      }
+
+      tree_.BuildFrom(first, last, threads);
+    } else {
+      for (; first != last; ++first) {
+        insert(*first);
+      }
     }
   }
 
   template<InputIterator<T> InputIt>
-  BST(InputIt first, InputIt last, const Allocator& alloc) : BST(first, last, Compare(), alloc) {
-    for (; first != last; ++first) {
-      insert(*first);
-    }
-  }
+  BST(InputIt first, InputIt last, const Allocator& alloc) : BST(first, last, Compare(), alloc) {}
 
   BST& operator=(const std::initializer_list<T>& list) {
     clear();
@@ -220,14 +241,37 @@ class BST {
       throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
     }
 
-    auto result = tree_.Insert(key, &key);
+    auto result = tree_.Insert(key, EmptyValue());
     iterator it = iterator(result.first, GetTraversalLink<Traversal>());
     return {it, result.second};
   }
 
   template<Traversable Traversal = DefaultTraversal>
   iterator insert(iterator pos, const T& key) {
-    return insert<Traversal>(key).first;
+    if (tree_.GetComparator()(key, key)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    return iterator(tree_.TryEmplaceFrom(GetFinger(pos), key).first, GetTraversalLink<Traversal>());
+  }
+
+  insert_return_type insert(node_type&& node) {
+    if (node.empty()) {
+      return {end(), false, node_type()};
+    }
+
+    if (!(node.get_allocator() == tree_.GetNodeAllocator())) {
+      throw std::invalid_argument("Node handle allocator is not equal to the container allocator");
+    }
+
+    auto result = tree_.InsertNode(node.Get());
+
+    if (result.second) {
+      node.Release();
+      return {iterator(result.first, in_order_), true, node_type()};
+    }
+
+    return {iterator(result.first, in_order_), false, std::move(node)};
   }
 
   template<InputIterator<T> InputIt>
@@ -245,6 +289,36 @@ class BST {
     }
   }
 
+  template<InputIterator<T> InputIt>
+  void insert_sorted_batch(InputIt first, InputIt last) {
+    if (first == last) {
+      return;
+    }
+
+    if (tree_.GetComparator()(*first, *first)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    tree_.InsertSorted(first, last);
+  }
+
+  // Sorts the keys in place; each run that falls into one gap of the tree is
+  // linked there as a balanced subtree.
+  void insert_batch(std::span<T> keys) {
+    if (keys.empty()) {
+      return;
+    }
+
+    Compare less = tree_.GetComparator();
+
+    if (less(keys.front(), keys.front())) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    std::sort(keys.begin(), keys.end(), less);
+    tree_.InsertSortedRuns(keys.begin(), keys.end());
+  }
+
   template<Iterable<T> Container>
   void insert(const Container& other) {
     insert(other.cbegin(), other.cend());
@@ -273,7 +347,16 @@ class BST {
     return next;
   }
 
+  void erase_without_successor(const_iterator pos) {
+    tree_.Delete(pos.current_);
+  }
+
   iterator erase(const_iterator first, const_iterator last) {
+    if (first.traversal_ == &in_order_) {
+      tree_.DeleteRange(first.current_, last.current_);
+      return last;
+    }
+
     while (first != last) {
       first = erase(first);
     }
@@ -282,14 +365,41 @@ class BST {
   }
 
   size_type erase(const T& key) {
-    size_type counter = 0;
+    return tree_.DeleteKey(key) ? 1 : 0;
+  }
 
-    for (auto it = find(key); it != end(); it = find(key)) {
-      erase(it);
-      ++counter;
-    }
+  node_type extract(const_iterator pos) {
+    return node_type(tree_.Extract(pos.current_), tree_.GetNodeAllocator());
+  }
+
+  node_type extract(const T& key) {
+    return node_type(tree_.Extract(tree_.FindFirst(key)), tree_.GetNodeAllocator());
+  }
+
+  void merge(BST& source) {
+    tree_.Merge(source.tree_);
+  }
 
-    return counter;
+  void merge(BST&& source) {
+    tree_.Merge(source.tree_);
+  }
+
+  friend BST set_union(const BST& lhs, const BST& rhs) {
+    BST result(lhs.key_comp(), lhs.get_allocator());
+    result.tree_.AssignSetOperation(lhs.tree_, rhs.tree_, true, true, true);
+    return result;
+  }
+
+  friend BST set_intersection(const BST& lhs, const BST& rhs) {
+    BST result(lhs.key_comp(), lhs.get_allocator());
+    result.tree_.AssignSetOperation(lhs.tree_, rhs.tree_, false, true, false);
+    return result;
+  }
+
+  friend BST set_difference(const BST& lhs, const BST& rhs) {
+    BST result(lhs.key_comp(), lhs.get_allocator());
+    result.tree_.AssignSetOperation(lhs.tree_, rhs.tree_, true, false, false);
+    return result;
   }
 
   template<Traversable Traversal = DefaultTraversal>
@@ -312,6 +422,21 @@ class BST {
     return iterator(tree_.FindFirst(key), GetTraversalLink<Traversal>());
   }
 
+  void find_batch(std::span<const T> keys, std::span<iterator> result) const {
+    if (result.size() < keys.size()) {
+      throw std::invalid_argument("Result span is shorter than the keys span");
+    }
+
+    tree_.FindBatch(keys.data(), keys.size(), [&](size_t index, NodeType* node) {
+      result[index] = iterator(node, in_order_);
+    });
+  }
+
+  iterator find_from(const_iterator pos, const T& key) const {
+    const ITraversal& traversal = (pos.traversal_ == nullptr) ? in_order_ : *pos.traversal_;
+    return iterator(tree_.FindFirstFrom(GetFinger(pos), key), traversal);
+  }
+
   size_type count(const T& key) const {
     return (find(key) == cend()) ? 0 : 1;
   }
@@ -376,6 +501,10 @@ class BST {
     return iterator(first, traversal);
   }
 
+  iterator lower_bound_from(const_iterator pos, const T& key) const {
+    return iterator(tree_.LowerBoundFrom(GetFinger(pos), key), in_order_);
+  }
+
   iterator upper_bound(const T& key) {
     return iterator(tree_.FindNext(key), in_order_);
   }
@@ -444,6 +573,11 @@ class BST {
     return {const_iterator(first, traversal), const_iterator(next, traversal)};
   }
 
+  aggregate_type aggregate(const T& lo, const T& hi) const
+  requires (!std::is_same<Augmentation, NoAugmentation>::value) {
+    return tree_.Aggregate(lo, hi);
+  }
+
   bool operator==(const BST& other) const {
     if (tree_.GetSize() != other.tree_.GetSize()) {
       return false;
@@ -517,16 +651,49 @@ class BST {
     return tree_.GetEquivalent();
   }
 
+  template<typename Function>
+  bool threaded_for_each(Function&& function) {
+    return tree_.TraverseThreaded([&](const NodeType* current) {
+      if constexpr (std::is_same<std::invoke_result_t<Function&, const T&>, bool>::value) {
+        return function(current->key);
+      } else {
+        function(current->key);
+        return true;
+      }
+    });
+  }
+
+  template<typename Function>
+  void parallel_for_each(Function&& function) const {
+    tree_.ParallelForEach([&](const NodeType* current) {
+      function(current->key);
+    });
+  }
+
+  // op must be associative; it is applied to (R, key) and to (R, R) pairs.
+  template<typename R, typename BinaryOp> requires std::constructible_from<R, const T&>
+  R parallel_reduce(R init, BinaryOp op) const {
+    return tree_.ParallelReduce(std::move(init), std::move(op));
+  }
+
+  // combine must be associative; R is built from and combined with transform(key).
+  template<typename R, typename Combine, typename Transform>
+  R parallel_transform_reduce(R init, Combine combine, Transform transform) const {
+    return tree_.ParallelReduce(std::move(init), std::move(combine), std::move(transform));
+  }
+
   template<Traversable Traversal = InOrder>
-  std::ostream& PrintToStream(std::ostream& os) {
-    tree_.template Traverse<Traversal>([&](const NodeType* current) -> void {
-      os << current->key << ' ';
+  std::ostream& PrintToStream(std::ostream& os, std::string_view separator = " ") const {
+    BstStreamWriter writer(os, separator, tree_.GetAllocator());
+    tree_.template Traverse<Traversal>([&](const NodeType* current) {
+      writer.Write(current->key);
     });
+    writer.Flush();
 
     return os;
   }
 
- private:
+ protected:
   TreeType tree_;
   PreOrder pre_order_;
   InOrder in_order_;
@@ -545,15 +712,20 @@ class BST {
       return post_order_;
     }
   }
+
+  // A default-constructed or end() iterator carries no finger: search from the root.
+  NodeType* GetFinger(const_iterator pos) const {
+    return (pos.traversal_ == nullptr || pos.current_ == tree_.GetEnd()) ? nullptr : pos.current_;
+  }
 };
 
-template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
-void swap(BST<T, Compare, Allocator>& first, BST<T, Compare, Allocator>& second) {
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation>
+void swap(BST<T, Compare, Allocator, Augmentation>& first, BST<T, Compare, Allocator, Augmentation>& second) {
   first.swap(second);
 }
 
-template<Allocable Key, Comparator<Key> Compare, AllocatorType Alloc, Predicate<Key> Pred>
-typename BST<Key, Compare, Alloc>::size_type erase_if(BST<Key, Compare, Alloc>& c, Pred pred) {
+template<Allocable Key, Comparator<Key> Compare, AllocatorType Alloc, AugmentationType<Key> Aug, Predicate<Key> Pred>
+typename BST<Key, Compare, Alloc, Aug>::size_type erase_if(BST<Key, Compare, Alloc, Aug>& c, Pred pred) {
   auto old_size = c.size();
 
   for (auto first = c.begin(), last = c.end(); first != last;) {
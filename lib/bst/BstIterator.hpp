@@ -11,13 +11,14 @@
 
 namespace bialger {
 
-template<Allocable T, Comparator<T> Compare, AllocatorType Allocator>
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation>
 class BST;
 
-template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, bool is_reversed = false>
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation,
+    bool is_reversed = false>
 class BstIterator {
  public:
-  friend class BST<T, Compare, Allocator>;
+  friend class BST<T, Compare, Allocator, Augmentation>;
 
   using iterator_category = std::bidirectional_iterator_tag;
   using difference_type = ptrdiff_t;
@@ -28,7 +29,7 @@ class BstIterator {
   using const_pointer = const T*;
 
  private:
-  using TreeInterface = BST<T, Compare, Allocator>::TreeInterface;
+  using TreeInterface = BST<T, Compare, Allocator, Augmentation>::TreeInterface;
   using NodeType = TreeInterface::NodeType;
 
  public:
@@ -44,7 +45,7 @@ class BstIterator {
   }
 
   BstIterator(const BstIterator& other)
-      : current_(other.current_), traversal_(other.traversal_), end_(other.traversal_->GetEnd()) {}
+      : current_(other.current_), traversal_(other.traversal_), end_(other.end_) {}
 
   BstIterator& operator=(const BstIterator& other) {
     if (this == &other) {
@@ -0,0 +1,341 @@
+#ifndef LIB_BST_BSTMAP_HPP_
+#define LIB_BST_BSTMAP_HPP_
+
+#include <limits>
+#include <stdexcept>
+
+#include "lib/tree/BinarySearchTree.hpp"
+#include "lib/tree/InOrder.hpp"
+#include "lib/tree/PreOrder.hpp"
+#include "lib/tree/PostOrder.hpp"
+
+#include "BstMapIterator.hpp"
+#include "BstConcepts.hpp"
+
+namespace bialger {
+
+template<Allocable K,
+    typename V,
+    Comparator<K> Compare = std::less<>,
+    AllocatorType Allocator = std::allocator<std::pair<const K, V>>>
+class BstMap {
+  static_assert(std::is_same<typename std::remove_cv<K>::type, K>::value,
+                "bialger::BstMap must have a non-const, non-volatile key_type");
+
+ protected:
+  using TreeType = BinarySearchTree<K, V, Compare, Allocator>;
+  using NodeType = TreeType::NodeType;
+  using DefaultTraversal = InOrder;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = BstMapIterator<K, V, Compare, Allocator>;
+  using const_iterator = BstMapIterator<K, V, Compare, Allocator, true>;
+  using reverse_iterator = BstMapIterator<K, V, Compare, Allocator, false, true>;
+  using const_reverse_iterator = BstMapIterator<K, V, Compare, Allocator, true, true>;
+  using reference = iterator::reference;
+  using const_reference = const_iterator::reference;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  BstMap() : tree_(), pre_order_(tree_), in_order_(tree_), post_order_(tree_) {}
+
+  explicit BstMap(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(false, comp, alloc), pre_order_(tree_), in_order_(tree_), post_order_(tree_) {}
+
+  explicit BstMap(const Allocator& alloc) : BstMap(Compare(), alloc) {}
+
+  BstMap(const std::initializer_list<value_type>& list,
+         const Compare& comp = Compare(),
+         const Allocator& alloc = Allocator()) : BstMap(comp, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  template<InputIterator<std::pair<K, V>> InputIt>
+  BstMap(InputIt first, InputIt last,
+         const Compare& comp = Compare(),
+         const Allocator& alloc = Allocator()) : BstMap(comp, alloc) {
+    insert(first, last);
+  }
+
+  BstMap(const BstMap& other) : tree_(other.tree_), pre_order_(tree_), in_order_(tree_), post_order_(tree_) {}
+
+  BstMap(BstMap&& other) noexcept: tree_(), pre_order_(tree_), in_order_(tree_), post_order_(tree_) {
+    std::swap(tree_, other.tree_);
+  }
+
+  BstMap& operator=(const BstMap& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    tree_ = other.tree_;
+    return *this;
+  }
+
+  BstMap& operator=(BstMap&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    std::swap(tree_, other.tree_);
+    return *this;
+  }
+
+  ~BstMap() {
+    tree_.Clear();
+  }
+
+  void clear() {
+    tree_.Clear();
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  iterator begin() {
+    return iterator(GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_iterator begin() const {
+    return const_iterator(GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  iterator end() {
+    return iterator(tree_.GetEnd(), GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_iterator end() const {
+    return const_iterator(tree_.GetEnd(), GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_iterator cbegin() const {
+    return begin<Traversal>();
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_iterator cend() const {
+    return end<Traversal>();
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  reverse_iterator rbegin() {
+    return reverse_iterator(GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  reverse_iterator rend() {
+    return reverse_iterator(tree_.GetEnd(), GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_reverse_iterator crbegin() const {
+    return const_reverse_iterator(GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_reverse_iterator crend() const {
+    return const_reverse_iterator(tree_.GetEnd(), GetTraversalLink<Traversal>());
+  }
+
+  V& operator[](const K& key) requires std::is_default_constructible<V>::value {
+    CheckComparator(key);
+    return tree_.TryEmplace(key).first->value;
+  }
+
+  V& at(const K& key) {
+    NodeType* node = tree_.FindFirst(key);
+
+    if (node == tree_.GetEnd()) {
+      throw std::out_of_range("BstMap::at: key not found");
+    }
+
+    return node->value;
+  }
+
+  const V& at(const K& key) const {
+    NodeType* node = tree_.FindFirst(key);
+
+    if (node == tree_.GetEnd()) {
+      throw std::out_of_range("BstMap::at: key not found");
+    }
+
+    return node->value;
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&& ... args) {
+    CheckComparator(key);
+    auto result = tree_.TryEmplace(key, std::forward<Args>(args)...);
+    return {iterator(result.first, in_order_), result.second};
+  }
+
+  template<typename M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& obj) {
+    CheckComparator(key);
+    auto result = tree_.TryEmplace(key, std::forward<M>(obj));
+
+    if (!result.second) {
+      result.first->value = std::forward<M>(obj);
+    }
+
+    return {iterator(result.first, in_order_), result.second};
+  }
+
+  std::pair<iterator, bool> insert(const value_type& pair) {
+    return try_emplace(pair.first, pair.second);
+  }
+
+  template<InputIterator<std::pair<K, V>> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(const std::initializer_list<value_type>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  iterator erase(iterator pos) {
+    iterator next = pos;
+    ++next;
+    tree_.Delete(pos.current_);
+    return next;
+  }
+
+  iterator erase(iterator first, iterator last) {
+    if (first.traversal_ == &in_order_) {
+      tree_.DeleteRange(first.current_, last.current_);
+      return last;
+    }
+
+    while (first != last) {
+      first = erase(first);
+    }
+
+    return last;
+  }
+
+  size_type erase(const K& key) {
+    return tree_.DeleteKey(key) ? 1 : 0;
+  }
+
+  iterator find(const K& key) {
+    return iterator(tree_.FindFirst(key), in_order_);
+  }
+
+  const_iterator find(const K& key) const {
+    return const_iterator(tree_.FindFirst(key), in_order_);
+  }
+
+  [[nodiscard]] size_type count(const K& key) const {
+    return tree_.Contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] bool contains(const K& key) const {
+    return tree_.Contains(key);
+  }
+
+  iterator lower_bound(const K& key) {
+    return iterator(LowerBound(key), in_order_);
+  }
+
+  const_iterator lower_bound(const K& key) const {
+    return const_iterator(LowerBound(key), in_order_);
+  }
+
+  iterator upper_bound(const K& key) {
+    return iterator(tree_.FindNext(key), in_order_);
+  }
+
+  const_iterator upper_bound(const K& key) const {
+    return const_iterator(tree_.FindNext(key), in_order_);
+  }
+
+  bool operator==(const BstMap& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+
+    for (auto this_it = cbegin(), other_it = other.cbegin(); this_it != cend(); ++this_it, ++other_it) {
+      if (this_it->first != other_it->first || this_it->second != other_it->second) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] size_type size() const {
+    return tree_.GetSize();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return tree_.GetSize() == 0;
+  }
+
+  static difference_type max_size() {
+    return std::numeric_limits<difference_type>::max();
+  }
+
+  void swap(BstMap& other) {
+    std::swap(tree_, other.tree_);
+  }
+
+  allocator_type get_allocator() const {
+    return tree_.GetAllocator();
+  }
+
+  key_compare key_comp() const {
+    return tree_.GetComparator();
+  }
+
+ protected:
+  TreeType tree_;
+  PreOrder pre_order_;
+  InOrder in_order_;
+  PostOrder post_order_;
+
+  template<Traversable Traversal>
+  [[nodiscard]] const ITraversal& GetTraversalLink() const {
+    if constexpr (std::is_same<Traversal, PreOrder>::value) {
+      return pre_order_;
+    } else if constexpr (std::is_same<Traversal, InOrder>::value) {
+      return in_order_;
+    } else {
+      return post_order_;
+    }
+  }
+
+  void CheckComparator(const K& key) const {
+    if (tree_.GetComparator()(key, key)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+  }
+
+  NodeType* LowerBound(const K& key) const {
+    NodeType* first = tree_.FindFirst(key);
+
+    if (first == tree_.GetEnd()) {
+      return tree_.FindNext(key);
+    }
+
+    return first;
+  }
+};
+
+template<Allocable K, typename V, Comparator<K> Compare, AllocatorType Allocator>
+void swap(BstMap<K, V, Compare, Allocator>& first, BstMap<K, V, Compare, Allocator>& second) {
+  first.swap(second);
+}
+
+} // bialger
+
+#endif //LIB_BST_BSTMAP_HPP_
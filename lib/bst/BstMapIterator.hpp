@@ -0,0 +1,120 @@
+#ifndef LIB_BST_BSTMAPITERATOR_HPP_
+#define LIB_BST_BSTMAPITERATOR_HPP_
+
+#include <iostream>
+#include <utility>
+
+#include "lib/tree/BinarySearchTree.hpp"
+#include "lib/tree/InOrder.hpp"
+#include "lib/tree/PreOrder.hpp"
+#include "lib/tree/PostOrder.hpp"
+
+namespace bialger {
+
+template<Allocable K, typename V, Comparator<K> Compare, AllocatorType Allocator>
+class BstMap;
+
+template<Allocable K, typename V, Comparator<K> Compare, AllocatorType Allocator,
+    bool is_const = false, bool is_reversed = false>
+class BstMapIterator {
+ public:
+  friend class BstMap<K, V, Compare, Allocator>;
+  friend class BstMapIterator<K, V, Compare, Allocator, !is_const, is_reversed>;
+
+ private:
+  using NodeType = TreeNode<K, V>;
+  using mapped_reference = std::conditional_t<is_const, const V&, V&>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = std::pair<const K, V>;
+  using reference = std::pair<const K&, mapped_reference>;
+  using const_reference = std::pair<const K&, const V&>;
+
+  struct pointer {
+    reference ref;
+
+    reference* operator->() {
+      return &ref;
+    }
+  };
+
+  BstMapIterator() : current_(nullptr), end_(nullptr), traversal_(nullptr) {}
+
+  explicit BstMapIterator(const ITraversal& traversal) : end_(traversal.GetEnd()), traversal_(&traversal) {
+    current_ = dynamic_cast<NodeType*>(is_reversed ? traversal_->GetLast() : traversal_->GetFirst());
+  }
+
+  BstMapIterator(ITreeNode* node, const ITraversal& traversal) : end_(traversal.GetEnd()), traversal_(&traversal) {
+    current_ = dynamic_cast<NodeType*>(node);
+  }
+
+  BstMapIterator(const BstMapIterator& other) = default;
+  BstMapIterator& operator=(const BstMapIterator& other) = default;
+
+  BstMapIterator(const BstMapIterator<K, V, Compare, Allocator, false, is_reversed>& other) requires is_const
+      : current_(other.current_), end_(other.end_), traversal_(other.traversal_) {}
+
+  reference operator*() const {
+    if (current_ == end_) {
+      throw std::out_of_range("Bad dereference attempt: *BstMap::end()");
+    }
+
+    return reference(current_->key, current_->value);
+  }
+
+  pointer operator->() const {
+    if (current_ == end_) {
+      throw std::out_of_range("Bad dereference attempt: BstMap::end()->");
+    }
+
+    return pointer{reference(current_->key, current_->value)};
+  }
+
+  BstMapIterator& operator++() {
+    if (current_ == end_) {
+      throw std::out_of_range("Bad incrementation attempt: ++BstMap::end()");
+    }
+
+    ITreeNode* next = is_reversed ? traversal_->GetPredecessor(current_) : traversal_->GetSuccessor(current_);
+    current_ = dynamic_cast<NodeType*>(next);
+
+    return *this;
+  }
+
+  BstMapIterator operator++(int) {
+    BstMapIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  BstMapIterator& operator--() {
+    ITreeNode* next = is_reversed ? traversal_->GetSuccessor(current_) : traversal_->GetPredecessor(current_);
+    current_ = dynamic_cast<NodeType*>(next);
+    return *this;
+  }
+
+  BstMapIterator operator--(int) {
+    BstMapIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const BstMapIterator& other) const {
+    return current_ == other.current_ && traversal_ == other.traversal_;
+  }
+
+  bool operator!=(const BstMapIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  NodeType* current_;
+  ITreeNode* end_;
+  const ITraversal* traversal_;
+};
+
+} // bialger
+
+#endif //LIB_BST_BSTMAPITERATOR_HPP_
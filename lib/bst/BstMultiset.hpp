@@ -0,0 +1,321 @@
+#ifndef LIB_BST_BSTMULTISET_HPP_
+#define LIB_BST_BSTMULTISET_HPP_
+
+#include <limits>
+#include <stdexcept>
+
+#include "lib/tree/BinarySearchTree.hpp"
+#include "lib/tree/InOrder.hpp"
+#include "lib/tree/PreOrder.hpp"
+#include "lib/tree/PostOrder.hpp"
+
+#include "BstMultisetIterator.hpp"
+#include "BstConcepts.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+class BstMultiset {
+  static_assert(std::is_same<typename std::remove_cv<T>::type, T>::value,
+                "bialger::BstMultiset must have a non-const, non-volatile value_type");
+
+ protected:
+  using TreeType = BinarySearchTree<T, size_t, Compare, Allocator>;
+  using NodeType = TreeType::NodeType;
+  using DefaultTraversal = InOrder;
+
+ public:
+  using key_type = T;
+  using value_type = key_type;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = BstMultisetIterator<T, Compare, Allocator>;
+  using const_iterator = BstMultisetIterator<T, Compare, Allocator>;
+  using reverse_iterator = BstMultisetIterator<T, Compare, Allocator, true>;
+  using const_reverse_iterator = BstMultisetIterator<T, Compare, Allocator, true>;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  BstMultiset() : tree_(), pre_order_(tree_), in_order_(tree_), post_order_(tree_), size_{} {}
+
+  explicit BstMultiset(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(false, comp, alloc), pre_order_(tree_), in_order_(tree_), post_order_(tree_), size_{} {}
+
+  explicit BstMultiset(const Allocator& alloc) : BstMultiset(Compare(), alloc) {}
+
+  BstMultiset(const std::initializer_list<T>& list,
+              const Compare& comp = Compare(),
+              const Allocator& alloc = Allocator()) : BstMultiset(comp, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  template<InputIterator<T> InputIt>
+  BstMultiset(InputIt first, InputIt last,
+              const Compare& comp = Compare(),
+              const Allocator& alloc = Allocator()) : BstMultiset(comp, alloc) {
+    insert(first, last);
+  }
+
+  BstMultiset(const BstMultiset& other)
+      : tree_(other.tree_), pre_order_(tree_), in_order_(tree_), post_order_(tree_), size_(other.size_) {}
+
+  BstMultiset(BstMultiset&& other) noexcept
+      : tree_(), pre_order_(tree_), in_order_(tree_), post_order_(tree_), size_{} {
+    std::swap(tree_, other.tree_);
+    std::swap(size_, other.size_);
+  }
+
+  BstMultiset& operator=(const BstMultiset& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    tree_ = other.tree_;
+    size_ = other.size_;
+    return *this;
+  }
+
+  BstMultiset& operator=(BstMultiset&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    std::swap(tree_, other.tree_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~BstMultiset() {
+    tree_.Clear();
+  }
+
+  void clear() {
+    tree_.Clear();
+    size_ = 0;
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  iterator begin() const {
+    return iterator(GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  iterator end() const {
+    return iterator(tree_.GetEnd(), GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_iterator cbegin() const {
+    return begin<Traversal>();
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_iterator cend() const {
+    return end<Traversal>();
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  reverse_iterator rbegin() const {
+    return reverse_iterator(GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  reverse_iterator rend() const {
+    return reverse_iterator(tree_.GetEnd(), GetTraversalLink<Traversal>());
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_reverse_iterator crbegin() const {
+    return rbegin<Traversal>();
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  const_reverse_iterator crend() const {
+    return rend<Traversal>();
+  }
+
+  iterator insert(const T& key, size_type repetitions = 1) {
+    if (tree_.GetComparator()(key, key)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    if (repetitions == 0) {
+      return find(key);
+    }
+
+    NodeType* node = tree_.TryEmplace(key, 0).first;
+    size_t index = node->value;
+    node->value += repetitions;
+    size_ += repetitions;
+
+    return iterator(node, in_order_, index);
+  }
+
+  template<InputIterator<T> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(const std::initializer_list<T>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  iterator erase(iterator pos) {
+    NodeType* node = pos.current_;
+    iterator next = pos;
+    ++next;
+    --size_;
+
+    if (node->value > 1) {
+      --node->value;
+      return (pos.index_ < node->value) ? pos : next;
+    }
+
+    tree_.Delete(node);
+    return next;
+  }
+
+  iterator erase(iterator first, iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+
+    return last;
+  }
+
+  size_type erase(const T& key) {
+    NodeType* node = tree_.FindFirst(key);
+
+    if (node == tree_.GetEnd()) {
+      return 0;
+    }
+
+    size_type erased = node->value;
+    size_ -= erased;
+    tree_.Delete(node);
+    return erased;
+  }
+
+  template<Traversable Traversal = DefaultTraversal>
+  iterator find(const T& key) const {
+    return iterator(tree_.FindFirst(key), GetTraversalLink<Traversal>());
+  }
+
+  size_type count(const T& key) const {
+    NodeType* node = tree_.FindFirst(key);
+    return (node == tree_.GetEnd()) ? 0 : node->value;
+  }
+
+  bool contains(const T& key) const {
+    return tree_.Contains(key);
+  }
+
+  iterator lower_bound(const T& key) const {
+    NodeType* first = tree_.FindFirst(key);
+
+    if (first == tree_.GetEnd()) {
+      return iterator(tree_.FindNext(key), in_order_);
+    }
+
+    return iterator(first, in_order_);
+  }
+
+  iterator upper_bound(const T& key) const {
+    return iterator(tree_.FindNext(key), in_order_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const T& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  bool operator==(const BstMultiset& other) const {
+    if (size_ != other.size_ || tree_.GetSize() != other.tree_.GetSize()) {
+      return false;
+    }
+
+    for (NodeType* this_node = GetFirst(), * other_node = other.GetFirst();
+         this_node != tree_.GetEnd();
+         this_node = GetNext(this_node), other_node = other.GetNext(other_node)) {
+      if (this_node->key != other_node->key || this_node->value != other_node->value) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] size_type size() const {
+    return size_;
+  }
+
+  [[nodiscard]] size_type distinct_size() const {
+    return tree_.GetSize();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return size_ == 0;
+  }
+
+  static difference_type max_size() {
+    return std::numeric_limits<difference_type>::max();
+  }
+
+  void swap(BstMultiset& other) {
+    std::swap(tree_, other.tree_);
+    std::swap(size_, other.size_);
+  }
+
+  allocator_type get_allocator() const {
+    return tree_.GetAllocator();
+  }
+
+  key_compare key_comp() const {
+    return tree_.GetComparator();
+  }
+
+  value_compare value_comp() const {
+    return tree_.GetComparator();
+  }
+
+ protected:
+  TreeType tree_;
+  PreOrder pre_order_;
+  InOrder in_order_;
+  PostOrder post_order_;
+  size_type size_;
+
+  template<Traversable Traversal>
+  [[nodiscard]] const ITraversal& GetTraversalLink() const {
+    if constexpr (std::is_same<Traversal, PreOrder>::value) {
+      return pre_order_;
+    } else if constexpr (std::is_same<Traversal, InOrder>::value) {
+      return in_order_;
+    } else {
+      return post_order_;
+    }
+  }
+
+  [[nodiscard]] NodeType* GetFirst() const {
+    return dynamic_cast<NodeType*>(in_order_.GetFirst());
+  }
+
+  [[nodiscard]] NodeType* GetNext(NodeType* node) const {
+    return dynamic_cast<NodeType*>(in_order_.GetSuccessor(node));
+  }
+};
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator>
+void swap(BstMultiset<T, Compare, Allocator>& first, BstMultiset<T, Compare, Allocator>& second) {
+  first.swap(second);
+}
+
+} // bialger
+
+#endif //LIB_BST_BSTMULTISET_HPP_
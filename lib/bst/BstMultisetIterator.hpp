@@ -0,0 +1,141 @@
+#ifndef LIB_BST_BSTMULTISETITERATOR_HPP_
+#define LIB_BST_BSTMULTISETITERATOR_HPP_
+
+#include <iostream>
+
+#include "lib/tree/BinarySearchTree.hpp"
+#include "lib/tree/InOrder.hpp"
+#include "lib/tree/PreOrder.hpp"
+#include "lib/tree/PostOrder.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator>
+class BstMultiset;
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, bool is_reversed = false>
+class BstMultisetIterator {
+ public:
+  friend class BstMultiset<T, Compare, Allocator>;
+
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+
+ private:
+  using NodeType = TreeNode<T, size_t>;
+
+ public:
+  BstMultisetIterator() : current_(nullptr), index_(0), end_(nullptr), traversal_(nullptr) {}
+
+  explicit BstMultisetIterator(const ITraversal& traversal)
+      : index_(0), end_(traversal.GetEnd()), traversal_(&traversal) {
+    current_ = dynamic_cast<NodeType*>(is_reversed ? traversal_->GetLast() : traversal_->GetFirst());
+
+    if (is_reversed && current_ != end_) {
+      index_ = current_->value - 1;
+    }
+  }
+
+  BstMultisetIterator(ITreeNode* node, const ITraversal& traversal, size_t index = 0)
+      : index_(index), end_(traversal.GetEnd()), traversal_(&traversal) {
+    current_ = dynamic_cast<NodeType*>(node);
+  }
+
+  BstMultisetIterator(const BstMultisetIterator& other) = default;
+  BstMultisetIterator& operator=(const BstMultisetIterator& other) = default;
+
+  const_reference operator*() const {
+    if (current_ == end_) {
+      throw std::out_of_range("Bad dereference attempt: *BstMultiset::end()");
+    }
+
+    return current_->key;
+  }
+
+  const_pointer operator->() const {
+    if (current_ == end_) {
+      throw std::out_of_range("Bad dereference attempt: BstMultiset::end()->");
+    }
+
+    return &current_->key;
+  }
+
+  BstMultisetIterator& operator++() {
+    if (current_ == end_) {
+      throw std::out_of_range("Bad incrementation attempt: ++BstMultiset::end()");
+    }
+
+    if constexpr (is_reversed) {
+      MoveBackward();
+    } else {
+      MoveForward();
+    }
+
+    return *this;
+  }
+
+  BstMultisetIterator operator++(int) {
+    BstMultisetIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  BstMultisetIterator& operator--() {
+    if constexpr (is_reversed) {
+      MoveForward();
+    } else {
+      MoveBackward();
+    }
+
+    return *this;
+  }
+
+  BstMultisetIterator operator--(int) {
+    BstMultisetIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const BstMultisetIterator& other) const {
+    return current_ == other.current_ && index_ == other.index_ && traversal_ == other.traversal_;
+  }
+
+  bool operator!=(const BstMultisetIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  NodeType* current_;
+  size_t index_;
+  ITreeNode* end_;
+  const ITraversal* traversal_;
+
+  void MoveForward() {
+    if (current_ != end_ && index_ + 1 < current_->value) {
+      ++index_;
+      return;
+    }
+
+    current_ = dynamic_cast<NodeType*>(traversal_->GetSuccessor(current_));
+    index_ = 0;
+  }
+
+  void MoveBackward() {
+    if (current_ != end_ && index_ > 0) {
+      --index_;
+      return;
+    }
+
+    current_ = dynamic_cast<NodeType*>(traversal_->GetPredecessor(current_));
+    index_ = (current_ == end_) ? 0 : current_->value - 1;
+  }
+};
+
+} // bialger
+
+#endif //LIB_BST_BSTMULTISETITERATOR_HPP_
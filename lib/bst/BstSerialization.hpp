@@ -0,0 +1,445 @@
+#ifndef LIB_BST_BSTSERIALIZATION_HPP_
+#define LIB_BST_BSTSERIALIZATION_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "BST.hpp"
+
+namespace bialger {
+
+/* Binary image of a sorted key sequence: a header with a byte order marker
+ * and the key count, the keys in order, and a checksum of everything before
+ * it. String-like keys are stored as a 64-bit length followed by their
+ * characters, other keys as raw native-endian bytes. Pointers and views would
+ * come back pointing into the writer's memory, so they are not serializable;
+ * neither are keys that hold pointers, which the concept cannot detect. */
+
+template<typename T>
+concept Serializable = !std::is_pointer<T>::value && !std::is_member_pointer<T>::value && !std::ranges::view<T>
+    && (std::is_trivially_copyable<T>::value
+        || (std::is_convertible<const T&, std::string_view>::value
+            && std::is_constructible<T, const char*, size_t>::value));
+
+/* Streaming 64-bit checksum in the style of xxHash64: four independent lanes
+ * take 8-byte words, so it runs at close to memory speed. */
+
+class BstChecksum {
+ public:
+  explicit BstChecksum(uint64_t seed = 0)
+      : lanes_{seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1},
+        seed_(seed),
+        tail_size_(0),
+        total_(0) {}
+
+  void Update(const char* data, size_t size) {
+    total_ += size;
+
+    if (tail_size_ > 0) {
+      size_t taken = std::min(size, kStripeSize - tail_size_);
+      std::memcpy(tail_ + tail_size_, data, taken);
+      tail_size_ += taken;
+      data += taken;
+      size -= taken;
+
+      if (tail_size_ < kStripeSize) {
+        return;
+      }
+
+      Consume(tail_);
+      tail_size_ = 0;
+    }
+
+    for (; size >= kStripeSize; data += kStripeSize, size -= kStripeSize) {
+      Consume(data);
+    }
+
+    std::memcpy(tail_, data, size);
+    tail_size_ = size;
+  }
+
+  [[nodiscard]] uint64_t Digest() const {
+    uint64_t hash;
+
+    if (total_ >= kStripeSize) {
+      hash = std::rotl(lanes_[0], 1) + std::rotl(lanes_[1], 7) + std::rotl(lanes_[2], 12) + std::rotl(lanes_[3], 18);
+
+      for (uint64_t lane : lanes_) {
+        hash = (hash ^ Round(0, lane)) * kPrime1 + kPrime4;
+      }
+    } else {
+      hash = seed_ + kPrime5;
+    }
+
+    hash += total_;
+    size_t offset = 0;
+
+    for (; offset + sizeof(uint64_t) <= tail_size_; offset += sizeof(uint64_t)) {
+      hash ^= Round(0, Load<uint64_t>(tail_ + offset));
+      hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+
+    for (; offset < tail_size_; ++offset) {
+      hash ^= static_cast<unsigned char>(tail_[offset]) * kPrime5;
+      hash = std::rotl(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+
+    return hash;
+  }
+
+ protected:
+  static constexpr size_t kStripeSize = 32;
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+  static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+  static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+  static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+  uint64_t lanes_[4];
+  uint64_t seed_;
+  char tail_[kStripeSize];
+  size_t tail_size_;
+  uint64_t total_;
+
+  template<typename Value>
+  static Value Load(const char* data) {
+    Value value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  static uint64_t Round(uint64_t lane, uint64_t word) {
+    return std::rotl(lane + word * kPrime2, 31) * kPrime1;
+  }
+
+  void Consume(const char* stripe) {
+    for (size_t i = 0; i < 4; ++i) {
+      lanes_[i] = Round(lanes_[i], Load<uint64_t>(stripe + i * sizeof(uint64_t)));
+    }
+  }
+};
+
+template<Serializable T>
+class BstSerializer {
+ public:
+  static constexpr char kMagic[4] = {'B', 'S', 'T', 'S'};
+  static constexpr uint32_t kVersion = 2;
+  static constexpr uint32_t kByteOrder = 0x01020304;
+  static constexpr uint32_t kForeignByteOrder = 0x04030201;
+  static constexpr bool kIsString = std::is_convertible<const T&, std::string_view>::value;
+  static constexpr uint32_t kKeySize = kIsString ? 0 : sizeof(T);
+
+  // One pass over the keys: each chunk is hashed as it is written.
+  template<typename InputIt, typename Allocator>
+  static void Write(std::ostream& os, InputIt first, uint64_t count, const Allocator& alloc) {
+    BstChecksum checksum;
+    auto sink = [&](const char* data, size_t size) {
+      checksum.Update(data, size);
+      os.write(data, static_cast<std::streamsize>(size));
+    };
+
+    sink(kMagic, sizeof(kMagic));
+    WriteValue(sink, kVersion);
+    WriteValue(sink, kByteOrder);
+    WriteValue(sink, kKeySize);
+    WriteValue(sink, count);
+    Encode(first, count, sink, alloc);
+
+    uint64_t digest = checksum.Digest();
+    os.write(reinterpret_cast<const char*>(&digest), sizeof(digest));
+  }
+
+  /* Memory grows with the bytes that actually arrive, so a forged count in
+   * the header fails as a truncated stream instead of allocating it. When the
+   * stream can report its remaining length the count is checked against it
+   * and the keys are read in one piece. */
+
+  template<typename Allocator>
+  static T* Read(std::istream& is, Allocator& alloc, uint64_t& count) {
+    BstChecksum checksum;
+    char magic[sizeof(kMagic)];
+    is.read(magic, sizeof(magic));
+
+    if (!is || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+      throw std::runtime_error("BST stream: bad magic");
+    }
+
+    checksum.Update(magic, sizeof(magic));
+
+    if (ReadValue<uint32_t>(is, checksum) != kVersion) {
+      throw std::runtime_error("BST stream: unsupported version");
+    }
+
+    uint32_t byte_order = ReadValue<uint32_t>(is, checksum);
+
+    if (byte_order != kByteOrder) {
+      throw std::runtime_error((byte_order == kForeignByteOrder)
+                               ? "BST stream: image has foreign byte order"
+                               : "BST stream: corrupted header");
+    }
+
+    if (ReadValue<uint32_t>(is, checksum) != kKeySize) {
+      throw std::runtime_error("BST stream: unsupported key type");
+    }
+
+    count = ReadValue<uint64_t>(is, checksum);
+    uint64_t record_size = kIsString ? sizeof(uint64_t) : sizeof(T);
+    std::optional<uint64_t> remaining = GetRemaining(is);
+
+    if (count > std::numeric_limits<uint64_t>::max() / record_size
+        || (remaining.has_value() && count * record_size > *remaining)) {
+      throw std::runtime_error("BST stream: size mismatch");
+    }
+
+    Buffer<T, Allocator> keys(alloc);
+    size_t grain = std::max<size_t>(1, kChunkSize / sizeof(T));
+    size_t first_capacity = remaining.has_value() ? count : std::min<uint64_t>(count, grain);
+
+    if constexpr (kIsString) {
+      using CharAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+      CharAllocator char_alloc(alloc);
+      Buffer<char, CharAllocator> scratch(char_alloc);
+      keys.Reserve(first_capacity);
+
+      for (uint64_t i = 0; i < count; ++i) {
+        uint64_t length = ReadValue<uint64_t>(is, checksum);
+
+        if (remaining.has_value() && length > *remaining) {
+          throw std::runtime_error("BST stream: record out of bounds");
+        }
+
+        scratch.size = 0;
+        ReadInto(is, scratch, length, kChunkSize, checksum);
+        keys.Reserve(Grow(keys.capacity, keys.size + 1, count));
+        std::allocator_traits<Allocator>::construct(alloc, keys.data + keys.size, scratch.data, length);
+        ++keys.size;
+      }
+    } else {
+      keys.Reserve(first_capacity);
+      ReadInto(is, keys, count, grain, checksum);
+    }
+
+    uint64_t expected = checksum.Digest();
+    uint64_t digest = 0;
+    is.read(reinterpret_cast<char*>(&digest), sizeof(digest));
+
+    if (!is || digest != expected) {
+      throw std::runtime_error("BST stream: truncated or corrupted payload");
+    }
+
+    return keys.Release();
+  }
+
+  template<typename Allocator>
+  static void Release(T* keys, uint64_t count, Allocator& alloc) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (uint64_t i = 0; i < count; ++i) {
+        std::allocator_traits<Allocator>::destroy(alloc, keys + i);
+      }
+    }
+
+    std::allocator_traits<Allocator>::deallocate(alloc, keys, count);
+  }
+
+ protected:
+  static constexpr size_t kChunkSize = 1 << 14;
+
+  // Constructed elements are [0, size); raw reads fill trivially copyable ones.
+  template<typename Element, typename Allocator>
+  struct Buffer {
+    using Traits = std::allocator_traits<Allocator>;
+
+    Allocator& allocator;
+    Element* data;
+    size_t size;
+    size_t capacity;
+
+    explicit Buffer(Allocator& alloc) : allocator(alloc), data(nullptr), size(0), capacity(0) {}
+
+    Buffer(const Buffer& other) = delete;
+    Buffer& operator=(const Buffer& other) = delete;
+
+    ~Buffer() {
+      if (data != nullptr) {
+        BstSerializer::Destroy(allocator, data, size, capacity);
+      }
+    }
+
+    void Reserve(size_t new_capacity) {
+      if (data != nullptr && new_capacity <= capacity) {
+        return;
+      }
+
+      Element* grown = Traits::allocate(allocator, new_capacity);
+
+      for (size_t i = 0; i < size; ++i) {
+        Traits::construct(allocator, grown + i, std::move(data[i]));
+      }
+
+      if (data != nullptr) {
+        BstSerializer::Destroy(allocator, data, size, capacity);
+      }
+
+      data = grown;
+      capacity = new_capacity;
+    }
+
+    Element* Release() {
+      Element* released = data;
+      data = nullptr;
+      return released;
+    }
+  };
+
+  template<typename Element, typename Allocator>
+  static void Destroy(Allocator& alloc, Element* data, size_t size, size_t capacity) {
+    for (size_t i = 0; i < size; ++i) {
+      std::allocator_traits<Allocator>::destroy(alloc, data + i);
+    }
+
+    std::allocator_traits<Allocator>::deallocate(alloc, data, capacity);
+  }
+
+  static size_t Grow(size_t capacity, size_t needed, uint64_t limit) {
+    return (needed <= capacity) ? capacity : static_cast<size_t>(std::min<uint64_t>(limit, 2 * capacity));
+  }
+
+  template<typename Element, typename Allocator>
+  static void ReadInto(std::istream& is, Buffer<Element, Allocator>& buffer, uint64_t count, size_t grain,
+                       BstChecksum& checksum) {
+    buffer.Reserve(std::min<uint64_t>(count, std::max<size_t>(buffer.capacity, grain)));
+
+    while (buffer.size < count) {
+      buffer.Reserve(Grow(buffer.capacity, buffer.size + 1, count));
+      size_t end = std::min<uint64_t>(buffer.capacity, count);
+      char* target = reinterpret_cast<char*>(buffer.data + buffer.size);
+      size_t bytes = (end - buffer.size) * sizeof(Element);
+      is.read(target, static_cast<std::streamsize>(bytes));
+
+      if (!is) {
+        throw std::runtime_error("BST stream: truncated or corrupted payload");
+      }
+
+      checksum.Update(target, bytes);
+      buffer.size = end;
+    }
+  }
+
+  static std::optional<uint64_t> GetRemaining(std::istream& is) {
+    std::istream::pos_type position = is.tellg();
+
+    if (position == std::istream::pos_type(-1) || !is.seekg(0, std::ios_base::end)) {
+      is.clear();
+      return std::nullopt;
+    }
+
+    std::istream::pos_type end = is.tellg();
+    is.seekg(position);
+
+    return (end < position) ? 0 : static_cast<uint64_t>(end - position);
+  }
+
+  template<typename Sink, typename Value>
+  static void WriteValue(Sink& sink, const Value& value) {
+    sink(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  template<typename Value>
+  static Value ReadValue(std::istream& is, BstChecksum& checksum) {
+    Value value{};
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+
+    if (!is) {
+      throw std::runtime_error("BST stream: truncated");
+    }
+
+    checksum.Update(reinterpret_cast<const char*>(&value), sizeof(value));
+    return value;
+  }
+
+  template<typename InputIt, typename Sink, typename Allocator>
+  static void Encode(InputIt first, uint64_t count, Sink& sink, const Allocator& alloc) {
+    using CharAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+    CharAllocator char_alloc(alloc);
+    Buffer<char, CharAllocator> chunk(char_alloc);
+    chunk.Reserve(kChunkSize);
+    char* buffer = chunk.data;
+    size_t used = 0;
+
+    auto append = [&](const char* data, size_t size) {
+      if (used + size > kChunkSize) {
+        sink(buffer, used);
+        used = 0;
+      }
+
+      if (size > kChunkSize) {
+        sink(data, size);
+      } else {
+        std::memcpy(buffer + used, data, size);
+        used += size;
+      }
+    };
+
+    for (uint64_t i = 0; i < count; ++i, ++first) {
+      if constexpr (kIsString) {
+        std::string_view key = *first;
+        uint64_t length = key.size();
+        append(reinterpret_cast<const char*>(&length), sizeof(length));
+        append(key.data(), key.size());
+      } else {
+        append(reinterpret_cast<const char*>(&*first), sizeof(T));
+      }
+    }
+
+    if (used > 0) {
+      sink(buffer, used);
+    }
+  }
+};
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation>
+requires Serializable<T>
+void serialize(const BST<T, Compare, Allocator, Augmentation>& bst, std::ostream& os) {
+  BstSerializer<T>::Write(os, bst.cbegin(), bst.size(), bst.get_allocator());
+}
+
+template<typename Tree>
+requires Serializable<typename Tree::key_type>
+Tree deserialize(std::istream& is,
+                 const typename Tree::key_compare& comp = typename Tree::key_compare(),
+                 const typename Tree::allocator_type& alloc = typename Tree::allocator_type()) {
+  using Serializer = BstSerializer<typename Tree::key_type>;
+  typename Tree::allocator_type key_allocator = alloc;
+  uint64_t count = 0;
+  typename Tree::key_type* keys = Serializer::Read(is, key_allocator, count);
+
+  try {
+    Tree result(keys, keys + count, comp, alloc);
+    Serializer::Release(keys, count, key_allocator);
+    return result;
+  } catch (...) {
+    Serializer::Release(keys, count, key_allocator);
+    throw;
+  }
+}
+
+} // bialger
+
+#endif //LIB_BST_BSTSERIALIZATION_HPP_
@@ -0,0 +1,298 @@
+#ifndef LIB_BST_BSTSTREAMREADER_HPP_
+#define LIB_BST_BSTSTREAMREADER_HPP_
+
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "BST.hpp"
+
+namespace bialger {
+
+/* Chunked reader for key files too large to hold twice in memory. Input is
+ * pulled through a fixed byte buffer and parsed into a fixed batch of keys
+ * that is handed to a sink before the next one is filled, so the reader's
+ * footprint does not depend on the input size (a text record longer than the
+ * buffer grows it to fit that record). Records are either text lines or raw
+ * native-endian images of trivially copyable keys. Lines end with LF or CRLF
+ * and empty lines are skipped; arithmetic keys are whitespace-trimmed and
+ * parsed with std::from_chars, string-like keys keep any other whitespace. */
+
+enum class RecordFormat {
+  kLines,
+  kBinary,
+};
+
+template<typename T>
+concept LineRecord = (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value)
+    || (std::is_convertible<const T&, std::string_view>::value && std::is_constructible<T, const char*, size_t>::value);
+
+template<typename T>
+concept StreamRecord = LineRecord<T> || std::is_trivially_copyable<T>::value;
+
+template<StreamRecord T>
+class BstStreamReader {
+ public:
+  static constexpr size_t kChunkSize = 1 << 16;
+  static constexpr size_t kBatchSize = 1 << 14;
+
+  template<typename Allocator, typename Sink>
+  static void ReadStream(std::istream& is, RecordFormat format, Allocator& alloc, Sink&& sink) {
+    Read([&is](char* data, size_t size) {
+      is.read(data, static_cast<std::streamsize>(size));
+
+      if (is.bad()) {
+        throw std::runtime_error("BST stream: read failed");
+      }
+
+      return static_cast<size_t>(is.gcount());
+    }, format, alloc, sink);
+  }
+
+#if defined(__unix__) || defined(__APPLE__)
+  template<typename Allocator, typename Sink>
+  static void ReadDescriptor(int fd, RecordFormat format, Allocator& alloc, Sink&& sink) {
+    Read([fd](char* data, size_t size) {
+      ssize_t count = ::read(fd, data, size);
+
+      while (count < 0 && errno == EINTR) {
+        count = ::read(fd, data, size);
+      }
+
+      if (count < 0) {
+        throw std::runtime_error("BST stream: read failed");
+      }
+
+      return static_cast<size_t>(count);
+    }, format, alloc, sink);
+  }
+#endif
+
+  template<typename Source, typename Allocator, typename Sink>
+  static void Read(Source&& source, RecordFormat format, Allocator& alloc, Sink&& sink) {
+    if constexpr (!LineRecord<T>) {
+      if (format == RecordFormat::kLines) {
+        throw std::invalid_argument("BST stream: keys cannot be parsed from text lines");
+      }
+    }
+
+    if constexpr (!std::is_trivially_copyable<T>::value) {
+      if (format == RecordFormat::kBinary) {
+        throw std::invalid_argument("BST stream: keys have no binary record format");
+      }
+    }
+
+    Scratch<Allocator> scratch(alloc);
+    size_t used = 0;
+    bool eof = false;
+
+    while (!eof) {
+      if (used == scratch.capacity) {
+        scratch.Grow();
+      }
+
+      size_t count = source(scratch.buffer + used, scratch.capacity - used);
+      eof = (count == 0);
+      used += count;
+
+      size_t consumed = (format == RecordFormat::kLines)
+                        ? ParseLines(scratch, used, eof, sink)
+                        : ParseRecords(scratch, used, eof, sink);
+
+      std::memmove(scratch.buffer, scratch.buffer + consumed, used - consumed);
+      used -= consumed;
+    }
+
+    scratch.Flush(sink);
+  }
+
+ protected:
+  template<typename Allocator>
+  struct Scratch {
+    using KeyAllocatorTraits = std::allocator_traits<Allocator>;
+    using CharAllocator = typename KeyAllocatorTraits::template rebind_alloc<char>;
+    using CharAllocatorTraits = std::allocator_traits<CharAllocator>;
+
+    Allocator& key_allocator;
+    CharAllocator char_allocator;
+    char* buffer;
+    size_t capacity;
+    T* batch;
+    size_t batch_size;
+
+    explicit Scratch(Allocator& alloc)
+        : key_allocator(alloc),
+          char_allocator(alloc),
+          buffer(CharAllocatorTraits::allocate(char_allocator, kChunkSize)),
+          capacity(kChunkSize),
+          batch(KeyAllocatorTraits::allocate(key_allocator, kBatchSize)),
+          batch_size(0) {}
+
+    Scratch(const Scratch& other) = delete;
+    Scratch& operator=(const Scratch& other) = delete;
+
+    ~Scratch() {
+      Clear();
+      KeyAllocatorTraits::deallocate(key_allocator, batch, kBatchSize);
+      CharAllocatorTraits::deallocate(char_allocator, buffer, capacity);
+    }
+
+    void Grow() {
+      char* grown = CharAllocatorTraits::allocate(char_allocator, 2 * capacity);
+      std::memcpy(grown, buffer, capacity);
+      CharAllocatorTraits::deallocate(char_allocator, buffer, capacity);
+      buffer = grown;
+      capacity *= 2;
+    }
+
+    template<typename... Args>
+    void Append(Args&& ... args) {
+      KeyAllocatorTraits::construct(key_allocator, batch + batch_size, std::forward<Args>(args)...);
+      ++batch_size;
+    }
+
+    template<typename Sink>
+    void Flush(Sink& sink) {
+      if (batch_size > 0) {
+        sink(batch, batch_size);
+        Clear();
+      }
+    }
+
+    void Clear() {
+      for (size_t i = 0; i < batch_size; ++i) {
+        KeyAllocatorTraits::destroy(key_allocator, batch + i);
+      }
+
+      batch_size = 0;
+    }
+  };
+
+  template<typename Allocator, typename Sink>
+  static size_t ParseLines(Scratch<Allocator>& scratch, size_t used, bool eof, Sink& sink) {
+    const char* data = scratch.buffer;
+    size_t start = 0;
+
+    while (start < used) {
+      const void* newline = std::memchr(data + start, '\n', used - start);
+
+      if (newline == nullptr && !eof) {
+        break;
+      }
+
+      size_t end = (newline == nullptr) ? used : static_cast<const char*>(newline) - data;
+      ParseLine(scratch, data + start, data + end);
+      start = (newline == nullptr) ? used : end + 1;
+
+      if (scratch.batch_size == kBatchSize) {
+        scratch.Flush(sink);
+      }
+    }
+
+    return start;
+  }
+
+  template<typename Allocator>
+  static void ParseLine(Scratch<Allocator>& scratch, const char* first, const char* last) {
+    if constexpr (std::is_arithmetic<T>::value) {
+      while (first != last && std::isspace(static_cast<unsigned char>(*first))) {
+        ++first;
+      }
+
+      while (last != first && std::isspace(static_cast<unsigned char>(last[-1]))) {
+        --last;
+      }
+
+      if (first == last) {
+        return;
+      }
+
+      T value{};
+      auto [end, error] = std::from_chars(first, last, value);
+
+      if (error != std::errc() || end != last) {
+        throw std::runtime_error("BST stream: malformed record");
+      }
+
+      scratch.Append(value);
+    } else if constexpr (LineRecord<T>) {
+      if (last != first && last[-1] == '\r') {
+        --last;
+      }
+
+      if (first != last) {
+        scratch.Append(first, static_cast<size_t>(last - first));
+      }
+    }
+  }
+
+  template<typename Allocator, typename Sink>
+  static size_t ParseRecords(Scratch<Allocator>& scratch, size_t used, bool eof, Sink& sink) {
+    size_t start = 0;
+
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      for (; used - start >= sizeof(T); start += sizeof(T)) {
+        T value;
+        std::memcpy(static_cast<void*>(&value), scratch.buffer + start, sizeof(T));
+        scratch.Append(value);
+
+        if (scratch.batch_size == kBatchSize) {
+          scratch.Flush(sink);
+        }
+      }
+    }
+
+    if (eof && start != used) {
+      throw std::runtime_error("BST stream: truncated record");
+    }
+
+    return start;
+  }
+};
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation>
+requires StreamRecord<T>
+void ingest(BST<T, Compare, Allocator, Augmentation>& bst, std::istream& is, RecordFormat format = RecordFormat::kLines) {
+  Allocator key_allocator = bst.get_allocator();
+  BstStreamReader<T>::ReadStream(is, format, key_allocator, [&bst](T* keys, size_t count) {
+    bst.insert_batch(std::span<T>(keys, count));
+  });
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation>
+requires StreamRecord<T>
+void ingest(BST<T, Compare, Allocator, Augmentation>& bst, int fd, RecordFormat format = RecordFormat::kLines) {
+  Allocator key_allocator = bst.get_allocator();
+  BstStreamReader<T>::ReadDescriptor(fd, format, key_allocator, [&bst](T* keys, size_t count) {
+    bst.insert_batch(std::span<T>(keys, count));
+  });
+}
+#endif
+
+template<typename Tree>
+requires StreamRecord<typename Tree::key_type>
+Tree from_stream(std::istream& is,
+                 RecordFormat format = RecordFormat::kLines,
+                 const typename Tree::key_compare& comp = typename Tree::key_compare(),
+                 const typename Tree::allocator_type& alloc = typename Tree::allocator_type()) {
+  Tree result(comp, alloc);
+  ingest(result, is, format);
+
+  return result;
+}
+
+} // bialger
+
+#endif //LIB_BST_BSTSTREAMREADER_HPP_
@@ -0,0 +1,138 @@
+#ifndef LIB_BST_BSTSTREAMWRITER_HPP_
+#define LIB_BST_BSTSTREAMWRITER_HPP_
+
+#include <charconv>
+#include <cstring>
+#include <locale>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace bialger {
+
+/* Buffered text dump of a key sequence. Keys are formatted into a fixed
+ * buffer, taken from the container's allocator rather than the stack, that
+ * reaches the stream in large writes: integers and floating
+ * point keys through std::to_chars, string-like keys by copying. The output
+ * matches operator<< as long as the stream has default formatting flags and
+ * the classic locale; otherwise, and for any other key type, each key goes
+ * through operator<< as before. */
+
+template<typename Allocator = std::allocator<char>>
+class BstStreamWriter {
+ public:
+  static constexpr size_t kChunkSize = 1 << 16;
+
+  BstStreamWriter(std::ostream& os, std::string_view separator, const Allocator& alloc = Allocator())
+      : os_(os),
+        separator_(separator),
+        precision_(static_cast<int>(os.precision())),
+        used_(0),
+        allocator_(alloc),
+        buffer_(CharAllocatorTraits::allocate(allocator_, kChunkSize)) {
+    std::ios_base::fmtflags extra = os.flags() & ~(std::ios_base::dec | std::ios_base::skipws | std::ios_base::unitbuf);
+    fast_ = extra == 0 && os.width() == 0 && os.getloc() == std::locale::classic();
+  }
+
+  BstStreamWriter(const BstStreamWriter& other) = delete;
+  BstStreamWriter& operator=(const BstStreamWriter& other) = delete;
+
+  ~BstStreamWriter() {
+    Flush();
+    CharAllocatorTraits::deallocate(allocator_, buffer_, kChunkSize);
+  }
+
+  template<typename T>
+  void Write(const T& key) {
+    if constexpr (kIsCharacter<T>) {
+      Append(reinterpret_cast<const char*>(&key), 1);
+    } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+      Append(std::string_view(key));
+    } else if constexpr (kIsNumber<T>) {
+      if (!fast_ || !Format(key)) {
+        Flush();
+        os_ << key;
+      }
+    } else {
+      Flush();
+      os_ << key;
+    }
+
+    Append(separator_);
+  }
+
+  void Flush() {
+    if (used_ > 0) {
+      os_.write(buffer_, static_cast<std::streamsize>(used_));
+      used_ = 0;
+    }
+  }
+
+ protected:
+  using CharAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+  using CharAllocatorTraits = std::allocator_traits<CharAllocator>;
+
+  static constexpr size_t kNumberSize = 128;
+
+  template<typename T>
+  static constexpr bool kIsCharacter = std::is_same<T, char>::value || std::is_same<T, signed char>::value
+      || std::is_same<T, unsigned char>::value;
+
+  template<typename T>
+  static constexpr bool kIsNumber = std::is_floating_point<T>::value
+      || (std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, wchar_t>::value
+          && !std::is_same<T, char8_t>::value && !std::is_same<T, char16_t>::value
+          && !std::is_same<T, char32_t>::value);
+
+  std::ostream& os_;
+  std::string_view separator_;
+  int precision_;
+  bool fast_;
+  size_t used_;
+  CharAllocator allocator_;
+  char* buffer_;
+
+  template<typename T>
+  bool Format(const T& key) {
+    if (kChunkSize - used_ < kNumberSize) {
+      Flush();
+    }
+
+    std::to_chars_result result;
+
+    if constexpr (std::is_floating_point<T>::value) {
+      result = std::to_chars(buffer_ + used_, buffer_ + kChunkSize, key, std::chars_format::general, precision_);
+    } else {
+      result = std::to_chars(buffer_ + used_, buffer_ + kChunkSize, key);
+    }
+
+    if (result.ec != std::errc()) {
+      return false;
+    }
+
+    used_ = result.ptr - buffer_;
+    return true;
+  }
+
+  void Append(std::string_view data) {
+    Append(data.data(), data.size());
+  }
+
+  void Append(const char* data, size_t size) {
+    if (size > kChunkSize - used_) {
+      Flush();
+    }
+
+    if (size > kChunkSize) {
+      os_.write(data, static_cast<std::streamsize>(size));
+    } else {
+      std::memcpy(buffer_ + used_, data, size);
+      used_ += size;
+    }
+  }
+};
+
+} // bialger
+
+#endif //LIB_BST_BSTSTREAMWRITER_HPP_
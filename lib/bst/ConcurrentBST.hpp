@@ -0,0 +1,139 @@
+#ifndef LIB_BST_CONCURRENTBST_HPP_
+#define LIB_BST_CONCURRENTBST_HPP_
+
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#include "BST.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+class ConcurrentBST {
+ public:
+  using container_type = BST<T, Compare, Allocator>;
+  using key_type = T;
+  using value_type = key_type;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  ConcurrentBST() = default;
+
+  explicit ConcurrentBST(const Compare& comp, const Allocator& alloc = Allocator()) : bst_(comp, alloc) {}
+
+  explicit ConcurrentBST(const Allocator& alloc) : bst_(alloc) {}
+
+  ConcurrentBST(const std::initializer_list<T>& list,
+                const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator()) : bst_(list, comp, alloc) {}
+
+  explicit ConcurrentBST(container_type bst) : bst_(std::move(bst)) {}
+
+  ConcurrentBST(const ConcurrentBST& other) = delete;
+  ConcurrentBST& operator=(const ConcurrentBST& other) = delete;
+
+  bool insert(const T& key) {
+    std::unique_lock lock(mutex_);
+    return bst_.insert(key).second;
+  }
+
+  template<InputIterator<T> InputIt>
+  void insert(InputIt first, InputIt last) {
+    std::unique_lock lock(mutex_);
+    bst_.insert(first, last);
+  }
+
+  void insert(const std::initializer_list<T>& list) {
+    std::unique_lock lock(mutex_);
+    bst_.insert(list);
+  }
+
+  size_type erase(const T& key) {
+    std::unique_lock lock(mutex_);
+    return bst_.erase(key);
+  }
+
+  void clear() {
+    std::unique_lock lock(mutex_);
+    bst_.clear();
+  }
+
+  [[nodiscard]] bool contains(const T& key) const {
+    std::shared_lock lock(mutex_);
+    return bst_.contains(key);
+  }
+
+  [[nodiscard]] size_type count(const T& key) const {
+    std::shared_lock lock(mutex_);
+    return bst_.count(key);
+  }
+
+  [[nodiscard]] std::optional<T> find(const T& key) const {
+    std::shared_lock lock(mutex_);
+    return Get(bst_.find(key));
+  }
+
+  [[nodiscard]] std::optional<T> lower_bound(const T& key) const {
+    std::shared_lock lock(mutex_);
+    return Get(bst_.lower_bound(key));
+  }
+
+  [[nodiscard]] std::optional<T> upper_bound(const T& key) const {
+    std::shared_lock lock(mutex_);
+    return Get(bst_.upper_bound(key));
+  }
+
+  [[nodiscard]] size_type size() const {
+    std::shared_lock lock(mutex_);
+    return bst_.size();
+  }
+
+  [[nodiscard]] bool empty() const {
+    std::shared_lock lock(mutex_);
+    return bst_.empty();
+  }
+
+  template<typename Function>
+  decltype(auto) read(Function&& function) const {
+    std::shared_lock lock(mutex_);
+    return std::forward<Function>(function)(std::as_const(bst_));
+  }
+
+  template<typename Function>
+  decltype(auto) write(Function&& function) {
+    std::unique_lock lock(mutex_);
+    return std::forward<Function>(function)(bst_);
+  }
+
+  [[nodiscard]] container_type snapshot() const {
+    std::shared_lock lock(mutex_);
+    return bst_;
+  }
+
+  allocator_type get_allocator() const {
+    return bst_.get_allocator();
+  }
+
+  key_compare key_comp() const {
+    return bst_.key_comp();
+  }
+
+ protected:
+  container_type bst_;
+  mutable std::shared_mutex mutex_;
+
+  std::optional<T> Get(const typename container_type::const_iterator& it) const {
+    if (it == bst_.cend()) {
+      return std::nullopt;
+    }
+
+    return *it;
+  }
+};
+
+} // bialger
+
+#endif //LIB_BST_CONCURRENTBST_HPP_
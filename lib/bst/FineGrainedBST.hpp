@@ -0,0 +1,124 @@
+#ifndef LIB_BST_FINEGRAINEDBST_HPP_
+#define LIB_BST_FINEGRAINEDBST_HPP_
+
+#include <optional>
+#include <stdexcept>
+
+#include "lib/tree/LockCouplingTree.hpp"
+#include "BstConcepts.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+class FineGrainedBST {
+  static_assert(std::is_same<typename std::remove_cv<T>::type, T>::value,
+                "bialger::FineGrainedBST must have a non-const, non-volatile value_type");
+
+ protected:
+  using TreeType = LockCouplingTree<T, Compare, Allocator>;
+
+ public:
+  using key_type = T;
+  using value_type = key_type;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  FineGrainedBST() : tree_() {}
+
+  explicit FineGrainedBST(const Compare& comp, const Allocator& alloc = Allocator()) : tree_(comp, alloc) {}
+
+  explicit FineGrainedBST(const Allocator& alloc) : FineGrainedBST(Compare(), alloc) {}
+
+  FineGrainedBST(const std::initializer_list<T>& list,
+                 const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator()) : FineGrainedBST(comp, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  FineGrainedBST(const FineGrainedBST& other) = delete;
+  FineGrainedBST& operator=(const FineGrainedBST& other) = delete;
+
+  bool insert(const T& key) {
+    if (tree_.GetComparator()(key, key)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    return tree_.Insert(key);
+  }
+
+  template<InputIterator<T> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(const std::initializer_list<T>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  size_type erase(const T& key) {
+    return tree_.Delete(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] bool contains(const T& key) const {
+    return tree_.Contains(key);
+  }
+
+  [[nodiscard]] size_type count(const T& key) const {
+    return tree_.Contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] std::optional<T> find(const T& key) const {
+    std::optional<T> bound = tree_.LowerBound(key);
+
+    if (bound.has_value() && tree_.GetComparator()(key, *bound)) {
+      return std::nullopt;
+    }
+
+    return bound;
+  }
+
+  [[nodiscard]] std::optional<T> lower_bound(const T& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  [[nodiscard]] std::optional<T> upper_bound(const T& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  [[nodiscard]] size_type size() const {
+    return tree_.GetSize();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return tree_.GetSize() == 0;
+  }
+
+  /* clear() and for_each() must not run concurrently with other operations. */
+
+  void clear() {
+    tree_.Clear();
+  }
+
+  template<typename Function>
+  void for_each(Function&& function) const {
+    tree_.TraverseInOrder(function);
+  }
+
+  allocator_type get_allocator() const {
+    return tree_.GetAllocator();
+  }
+
+  key_compare key_comp() const {
+    return tree_.GetComparator();
+  }
+
+ protected:
+  TreeType tree_;
+};
+
+} // bialger
+
+#endif //LIB_BST_FINEGRAINEDBST_HPP_
@@ -0,0 +1,113 @@
+#ifndef LIB_BST_FROZENBSTITERATOR_HPP_
+#define LIB_BST_FROZENBSTITERATOR_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace bialger {
+
+template<typename T, typename Compare>
+class FrozenBstView;
+
+template<typename T, typename Compare>
+class FrozenBstIterator {
+ public:
+  friend class FrozenBstView<T, Compare>;
+
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = T;
+  using reference = const T&;
+  using const_reference = const T&;
+  using pointer = const T*;
+  using const_pointer = const T*;
+
+  FrozenBstIterator() : keys_(nullptr), size_(0), index_(0) {}
+
+  FrozenBstIterator(const T* keys, size_t size, size_t index) : keys_(keys), size_(size), index_(index) {}
+
+  const_reference operator*() const {
+    if (index_ == 0) {
+      throw std::out_of_range("Bad dereference attempt: *FrozenBstView::end()");
+    }
+
+    return keys_[index_ - 1];
+  }
+
+  const_pointer operator->() const {
+    if (index_ == 0) {
+      throw std::out_of_range("Bad dereference attempt: FrozenBstView::end()->");
+    }
+
+    return &keys_[index_ - 1];
+  }
+
+  FrozenBstIterator& operator++() {
+    if (index_ == 0) {
+      throw std::out_of_range("Bad incrementation attempt: ++FrozenBstView::end()");
+    }
+
+    if (2 * index_ + 1 <= size_) {
+      index_ = 2 * index_ + 1;
+
+      while (2 * index_ <= size_) {
+        index_ *= 2;
+      }
+    } else {
+      index_ >>= std::countr_one(index_) + 1;
+    }
+
+    return *this;
+  }
+
+  FrozenBstIterator operator++(int) {
+    FrozenBstIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  FrozenBstIterator& operator--() {
+    if (index_ == 0) {
+      index_ = (size_ == 0) ? 0 : 1;
+
+      while (2 * index_ + 1 <= size_) {
+        index_ = 2 * index_ + 1;
+      }
+    } else if (2 * index_ <= size_) {
+      index_ *= 2;
+
+      while (2 * index_ + 1 <= size_) {
+        index_ = 2 * index_ + 1;
+      }
+    } else {
+      index_ >>= std::countr_zero(index_) + 1;
+    }
+
+    return *this;
+  }
+
+  FrozenBstIterator operator--(int) {
+    FrozenBstIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const FrozenBstIterator& other) const {
+    return index_ == other.index_ && keys_ == other.keys_;
+  }
+
+  bool operator!=(const FrozenBstIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  const T* keys_;
+  size_t size_;
+  size_t index_;
+};
+
+} // bialger
+
+#endif //LIB_BST_FROZENBSTITERATOR_HPP_
@@ -0,0 +1,324 @@
+#ifndef LIB_BST_FROZENBSTVIEW_HPP_
+#define LIB_BST_FROZENBSTVIEW_HPP_
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "BST.hpp"
+#include "BstSerialization.hpp"
+#include "FrozenBstIterator.hpp"
+
+namespace bialger {
+
+/* Read-only image of a set of trivially copyable keys that is used in place,
+ * typically straight from an mmap. The keys are stored in Eytzinger order:
+ * key k has its children at 2k and 2k + 1, so the tree needs no pointers and
+ * every search touches the top levels that stay hot in cache. Sorted
+ * iteration walks the implicit tree by index arithmetic. */
+
+struct FrozenBstHeader {
+  static constexpr char kMagic[4] = {'B', 'S', 'T', 'F'};
+  static constexpr uint32_t kVersion = 2;
+  static constexpr uint64_t kKeysOffset = 64;
+
+  char magic[4];
+  uint32_t version;
+  uint32_t key_size;
+  uint32_t key_alignment;
+  uint64_t count;
+  uint64_t keys_offset;
+  uint64_t checksum;
+};
+
+template<typename T, typename Compare = std::less<>>
+class FrozenBstView {
+  static_assert(std::is_trivially_copyable<T>::value, "bialger::FrozenBstView requires trivially copyable keys");
+  static_assert(alignof(T) <= FrozenBstHeader::kKeysOffset, "bialger::FrozenBstView key alignment is too large");
+
+ public:
+  using key_type = T;
+  using value_type = key_type;
+  using reference = const T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using iterator = FrozenBstIterator<T, Compare>;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+  using key_compare = Compare;
+
+  FrozenBstView() : keys_(nullptr), size_(0), checksum_(0), mapping_(nullptr), mapping_size_(0), less_() {}
+
+  FrozenBstView(const void* image, size_t image_size, const Compare& comp = Compare())
+      : keys_(nullptr), size_(0), checksum_(0), mapping_(nullptr), mapping_size_(0), less_(comp) {
+    Attach(image, image_size);
+  }
+
+  FrozenBstView(const FrozenBstView& other) = delete;
+  FrozenBstView& operator=(const FrozenBstView& other) = delete;
+
+  FrozenBstView(FrozenBstView&& other) noexcept : FrozenBstView() {
+    swap(other);
+  }
+
+  FrozenBstView& operator=(FrozenBstView&& other) noexcept {
+    FrozenBstView moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  ~FrozenBstView() {
+    Unmap();
+  }
+
+  static FrozenBstView map(const std::string& path, const Compare& comp = Compare()) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+      throw std::runtime_error("Frozen BST image: cannot open " + path);
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+      ::close(fd);
+      throw std::runtime_error("Frozen BST image: cannot stat " + path);
+    }
+
+    auto length = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapping == MAP_FAILED) {
+      throw std::runtime_error("Frozen BST image: cannot map " + path);
+    }
+
+    FrozenBstView view;
+    view.less_ = comp;
+    view.mapping_ = mapping;
+    view.mapping_size_ = length;
+    view.Attach(mapping, length);
+    return view;
+#else
+    throw std::runtime_error("Frozen BST image: memory mapping is not supported on this platform");
+#endif
+  }
+
+  // The Eytzinger copy of the keys is taken through alloc, rebound to T.
+  template<typename InputIt, typename Allocator = std::allocator<T>>
+  static void write(std::ostream& os, InputIt first, uint64_t count, const Allocator& alloc = Allocator()) {
+    using KeyAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using KeyAllocatorTraits = std::allocator_traits<KeyAllocator>;
+    KeyAllocator allocator(alloc);
+    T* keys = KeyAllocatorTraits::allocate(allocator, count);
+    Fill(keys, count, 1, first);
+
+    FrozenBstHeader header{};
+    std::memcpy(header.magic, FrozenBstHeader::kMagic, sizeof(header.magic));
+    header.version = FrozenBstHeader::kVersion;
+    header.key_size = sizeof(T);
+    header.key_alignment = alignof(T);
+    header.count = count;
+    header.keys_offset = FrozenBstHeader::kKeysOffset;
+    header.checksum = Checksum(keys, count);
+
+    char padding[FrozenBstHeader::kKeysOffset] = {};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(padding, FrozenBstHeader::kKeysOffset - sizeof(header));
+    os.write(reinterpret_cast<const char*>(keys), static_cast<std::streamsize>(count * sizeof(T)));
+    KeyAllocatorTraits::deallocate(allocator, keys, count);
+  }
+
+  [[nodiscard]] bool verify() const {
+    return Checksum(keys_, size_) == checksum_;
+  }
+
+  iterator begin() const {
+    size_t index = (size_ == 0) ? 0 : 1;
+
+    while (2 * index <= size_ && index != 0) {
+      index *= 2;
+    }
+
+    return iterator(keys_, size_, index);
+  }
+
+  iterator end() const {
+    return iterator(keys_, size_, 0);
+  }
+
+  const_iterator cbegin() const {
+    return begin();
+  }
+
+  const_iterator cend() const {
+    return end();
+  }
+
+  reverse_iterator rbegin() const {
+    return reverse_iterator(end());
+  }
+
+  reverse_iterator rend() const {
+    return reverse_iterator(begin());
+  }
+
+  iterator find(const T& key) const {
+    size_t index = LowerBound(key);
+
+    if (index == 0 || less_(key, keys_[index - 1])) {
+      return end();
+    }
+
+    return iterator(keys_, size_, index);
+  }
+
+  [[nodiscard]] size_type count(const T& key) const {
+    return (find(key) == end()) ? 0 : 1;
+  }
+
+  [[nodiscard]] bool contains(const T& key) const {
+    return find(key) != end();
+  }
+
+  iterator lower_bound(const T& key) const {
+    return iterator(keys_, size_, LowerBound(key));
+  }
+
+  iterator upper_bound(const T& key) const {
+    size_t index = 1;
+
+    while (index <= size_) {
+      index = 2 * index + (less_(key, keys_[index - 1]) ? 0 : 1);
+    }
+
+    return iterator(keys_, size_, index >> (std::countr_one(index) + 1));
+  }
+
+  std::pair<iterator, iterator> equal_range(const T& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  [[nodiscard]] size_type size() const {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return size_ == 0;
+  }
+
+  key_compare key_comp() const {
+    return less_;
+  }
+
+  void swap(FrozenBstView& other) noexcept {
+    std::swap(keys_, other.keys_);
+    std::swap(size_, other.size_);
+    std::swap(checksum_, other.checksum_);
+    std::swap(mapping_, other.mapping_);
+    std::swap(mapping_size_, other.mapping_size_);
+    std::swap(less_, other.less_);
+  }
+
+ protected:
+  const T* keys_;
+  size_t size_;
+  uint64_t checksum_;
+  void* mapping_;
+  size_t mapping_size_;
+  Compare less_;
+
+  void Attach(const void* image, size_t image_size) {
+    FrozenBstHeader header{};
+
+    if (image_size < FrozenBstHeader::kKeysOffset) {
+      throw std::runtime_error("Frozen BST image: truncated header");
+    }
+
+    std::memcpy(&header, image, sizeof(header));
+
+    if (std::memcmp(header.magic, FrozenBstHeader::kMagic, sizeof(header.magic)) != 0
+        || header.version != FrozenBstHeader::kVersion) {
+      throw std::runtime_error("Frozen BST image: bad magic or version");
+    }
+
+    if (header.key_size != sizeof(T) || header.key_alignment != alignof(T)) {
+      throw std::runtime_error("Frozen BST image: key type mismatch");
+    }
+
+    const char* keys = static_cast<const char*>(image) + header.keys_offset;
+
+    if (header.keys_offset < sizeof(header) || header.keys_offset > image_size
+        || header.count > (image_size - header.keys_offset) / sizeof(T)
+        || reinterpret_cast<uintptr_t>(keys) % alignof(T) != 0) {
+      throw std::runtime_error("Frozen BST image: keys out of bounds or misaligned");
+    }
+
+    keys_ = reinterpret_cast<const T*>(keys);
+    size_ = header.count;
+    checksum_ = header.checksum;
+  }
+
+  void Unmap() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mapping_size_);
+    }
+#endif
+
+    mapping_ = nullptr;
+  }
+
+  size_t LowerBound(const T& key) const {
+    size_t index = 1;
+
+    while (index <= size_) {
+      index = 2 * index + (less_(keys_[index - 1], key) ? 1 : 0);
+    }
+
+    return index >> (std::countr_one(index) + 1);
+  }
+
+  static uint64_t Checksum(const T* keys, size_t count) {
+    BstChecksum checksum;
+    checksum.Update(reinterpret_cast<const char*>(keys), count * sizeof(T));
+    return checksum.Digest();
+  }
+
+  template<typename InputIt>
+  static void Fill(T* keys, size_t count, size_t index, InputIt& it) {
+    if (index > count) {
+      return;
+    }
+
+    Fill(keys, count, 2 * index, it);
+    std::memcpy(static_cast<void*>(keys + index - 1), &*it, sizeof(T));
+    ++it;
+    Fill(keys, count, 2 * index + 1, it);
+  }
+};
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator, AugmentationType<T> Augmentation>
+requires std::is_trivially_copyable<T>::value
+void freeze(const BST<T, Compare, Allocator, Augmentation>& bst, std::ostream& os) {
+  FrozenBstView<T, Compare>::write(os, bst.cbegin(), bst.size(), bst.get_allocator());
+}
+
+} // bialger
+
+#endif //LIB_BST_FROZENBSTVIEW_HPP_
@@ -0,0 +1,184 @@
+#ifndef LIB_BST_INTERVALTREE_HPP_
+#define LIB_BST_INTERVALTREE_HPP_
+
+#include <utility>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "BST.hpp"
+
+namespace bialger {
+
+template<typename T, Comparator<T> Compare>
+struct IntervalLess {
+  using interval_type = std::pair<T, T>;
+
+  IntervalLess() = default;
+
+  explicit IntervalLess(const Compare& comp) : comparator_(comp) {}
+
+  bool operator()(const interval_type& lhs, const interval_type& rhs) const {
+    if (comparator_(lhs.first, rhs.first)) {
+      return true;
+    }
+
+    if (comparator_(rhs.first, lhs.first)) {
+      return false;
+    }
+
+    return comparator_(lhs.second, rhs.second);
+  }
+
+  [[nodiscard]] Compare GetEndpointComparator() const {
+    return comparator_;
+  }
+
+ protected:
+  Compare comparator_{};
+};
+
+/* Caches the greatest upper endpoint of a subtree; an empty subtree has none,
+ * so the identity does not depend on the key type or on the ordering. The
+ * augmentation is stateless, hence IntervalTree only accepts a stateless
+ * Compare: a default-constructed one orders exactly as the stored one. */
+
+template<typename T, Comparator<T> Compare>
+struct IntervalAugmentation {
+  using value_type = std::optional<T>;
+
+  static value_type Lift(const std::pair<T, T>& key) {
+    return key.second;
+  }
+
+  static value_type Identity() {
+    return std::nullopt;
+  }
+
+  static value_type Combine(const value_type& lhs, const value_type& rhs) {
+    if (!lhs.has_value()) {
+      return rhs;
+    }
+
+    if (!rhs.has_value()) {
+      return lhs;
+    }
+
+    return Compare()(*lhs, *rhs) ? rhs : lhs;
+  }
+};
+
+/* Set of closed intervals [lo, hi] ordered by (lo, hi). Like the underlying
+ * BST it has set semantics: inserting an interval equal to a stored one is a
+ * no-op that returns false. */
+
+template<Allocable T,
+    Comparator<T> Compare = std::less<>,
+    AllocatorType Allocator = std::allocator<std::pair<T, T>>>
+class IntervalTree : public BST<std::pair<T, T>,
+                                IntervalLess<T, Compare>,
+                                Allocator,
+                                IntervalAugmentation<T, Compare>> {
+  static_assert(std::is_empty<Compare>::value,
+                "bialger::IntervalTree requires a stateless Compare: the max-endpoint augmentation cannot store it");
+
+ private:
+  using BaseType = BST<std::pair<T, T>, IntervalLess<T, Compare>, Allocator, IntervalAugmentation<T, Compare>>;
+  using NodeType = BaseType::NodeType;
+
+ public:
+  using endpoint_type = T;
+  using interval_type = std::pair<T, T>;
+  using endpoint_compare = Compare;
+
+  IntervalTree() : BaseType() {}
+
+  explicit IntervalTree(const Compare& comp, const Allocator& alloc = Allocator())
+      : BaseType(IntervalLess<T, Compare>(comp), alloc) {}
+
+  explicit IntervalTree(const Allocator& alloc) : BaseType(alloc) {}
+
+  IntervalTree(const std::initializer_list<interval_type>& list,
+               const Compare& comp = Compare(),
+               const Allocator& alloc = Allocator()) : BaseType(IntervalLess<T, Compare>(comp), alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  std::pair<typename BaseType::iterator, bool> insert(const interval_type& interval) {
+    CheckInterval(interval);
+    return BaseType::insert(interval);
+  }
+
+  std::pair<typename BaseType::iterator, bool> insert(const T& lo, const T& hi) {
+    return insert(interval_type(lo, hi));
+  }
+
+  typename BaseType::iterator insert(typename BaseType::iterator pos, const interval_type& interval) {
+    CheckInterval(interval);
+    return BaseType::insert(pos, interval);
+  }
+
+  template<InputIterator<interval_type> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  template<Iterable<interval_type> Container>
+  void insert(const Container& other) {
+    insert(other.cbegin(), other.cend());
+  }
+
+  void insert(const std::initializer_list<interval_type>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  template<std::output_iterator<const interval_type&> OutputIt>
+  OutputIt overlapping(const T& point, OutputIt out) const {
+    return overlapping(point, point, out);
+  }
+
+  template<std::output_iterator<const interval_type&> OutputIt>
+  OutputIt overlapping(const T& lo, const T& hi, OutputIt out) const {
+    const Compare comparator = this->tree_.GetComparator().GetEndpointComparator();
+    CollectOverlapping(dynamic_cast<const NodeType*>(this->tree_.GetRoot()), lo, hi, comparator, out);
+    return out;
+  }
+
+ private:
+  void CheckInterval(const interval_type& interval) const {
+    if (this->tree_.GetComparator().GetEndpointComparator()(interval.second, interval.first)) {
+      throw std::invalid_argument("Incorrect interval: upper endpoint is less than lower endpoint");
+    }
+  }
+
+  template<typename OutputIt>
+  static void CollectOverlapping(const NodeType* node,
+                                 const T& lo,
+                                 const T& hi,
+                                 const Compare& comparator,
+                                 OutputIt& out) {
+    if (node == nullptr || !node->aggregate.has_value() || comparator(*node->aggregate, lo)) {
+      return;
+    }
+
+    CollectOverlapping(node->left, lo, hi, comparator, out);
+
+    if (comparator(hi, node->key.first)) {
+      return;
+    }
+
+    if (!comparator(node->key.second, lo)) {
+      *out = node->key;
+      ++out;
+    }
+
+    CollectOverlapping(node->right, lo, hi, comparator, out);
+  }
+};
+
+} // bialger
+
+#endif //LIB_BST_INTERVALTREE_HPP_
@@ -0,0 +1,220 @@
+#ifndef LIB_BST_PERSISTENTBST_HPP_
+#define LIB_BST_PERSISTENTBST_HPP_
+
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "lib/tree/PersistentTree.hpp"
+
+#include "PersistentBstIterator.hpp"
+#include "BstConcepts.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+class PersistentBST {
+  static_assert(std::is_same<typename std::remove_cv<T>::type, T>::value,
+                "bialger::PersistentBST must have a non-const, non-volatile value_type");
+
+ protected:
+  using TreeType = PersistentTree<T, Compare, Allocator>;
+
+ public:
+  using key_type = T;
+  using value_type = key_type;
+  using reference = const T&;
+  using const_reference = const T&;
+  using pointer = const T*;
+  using const_pointer = const T*;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = PersistentBstIterator<T, Compare, Allocator>;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  PersistentBST() : tree_() {}
+
+  explicit PersistentBST(const Compare& comp, const Allocator& alloc = Allocator()) : tree_(comp, alloc) {}
+
+  explicit PersistentBST(const Allocator& alloc) : PersistentBST(Compare(), alloc) {}
+
+  PersistentBST(const std::initializer_list<T>& list,
+                const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator()) : PersistentBST(comp, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  template<InputIterator<T> InputIt>
+  PersistentBST(InputIt first, InputIt last,
+                const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator()) : PersistentBST(comp, alloc) {
+    insert(first, last);
+  }
+
+  PersistentBST(const PersistentBST& other) = default;
+  PersistentBST(PersistentBST&& other) noexcept = default;
+  PersistentBST& operator=(const PersistentBST& other) = default;
+  PersistentBST& operator=(PersistentBST&& other) noexcept = default;
+  ~PersistentBST() = default;
+
+  [[nodiscard]] PersistentBST snapshot() const {
+    return *this;
+  }
+
+  void clear() {
+    tree_.Clear();
+  }
+
+  iterator begin() const {
+    return iterator(tree_.GetFirst(), tree_);
+  }
+
+  iterator end() const {
+    return iterator(nullptr, tree_);
+  }
+
+  const_iterator cbegin() const {
+    return begin();
+  }
+
+  const_iterator cend() const {
+    return end();
+  }
+
+  reverse_iterator rbegin() const {
+    return reverse_iterator(end());
+  }
+
+  reverse_iterator rend() const {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator crbegin() const {
+    return rbegin();
+  }
+
+  const_reverse_iterator crend() const {
+    return rend();
+  }
+
+  std::pair<iterator, bool> insert(const T& key) {
+    if (tree_.GetComparator()(key, key)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    bool inserted = tree_.Insert(key);
+    return {find(key), inserted};
+  }
+
+  template<InputIterator<T> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(const std::initializer_list<T>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  iterator erase(const_iterator pos) {
+    if (pos == end()) {
+      return end();
+    }
+
+    T key = *pos;
+    tree_.Delete(key);
+    return upper_bound(key);
+  }
+
+  size_type erase(const T& key) {
+    return tree_.Delete(key) ? 1 : 0;
+  }
+
+  iterator find(const T& key) const {
+    return iterator(tree_.FindFirst(key), tree_);
+  }
+
+  [[nodiscard]] size_type count(const T& key) const {
+    return (tree_.FindFirst(key) == nullptr) ? 0 : 1;
+  }
+
+  [[nodiscard]] bool contains(const T& key) const {
+    return tree_.FindFirst(key) != nullptr;
+  }
+
+  iterator lower_bound(const T& key) const {
+    return iterator(tree_.LowerBound(key), tree_);
+  }
+
+  iterator upper_bound(const T& key) const {
+    return iterator(tree_.UpperBound(key), tree_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const T& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  bool operator==(const PersistentBST& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+
+    if (tree_.GetRoot() == other.tree_.GetRoot()) {
+      return true;
+    }
+
+    for (auto this_it = begin(), other_it = other.begin(); this_it != end(); ++this_it, ++other_it) {
+      if (*this_it != *other_it) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] size_type size() const {
+    return tree_.GetSize();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return tree_.GetSize() == 0;
+  }
+
+  static difference_type max_size() {
+    return std::numeric_limits<difference_type>::max();
+  }
+
+  void swap(PersistentBST& other) {
+    std::swap(tree_, other.tree_);
+  }
+
+  allocator_type get_allocator() const {
+    return tree_.GetAllocator();
+  }
+
+  key_compare key_comp() const {
+    return tree_.GetComparator();
+  }
+
+  value_compare value_comp() const {
+    return tree_.GetComparator();
+  }
+
+ protected:
+  TreeType tree_;
+};
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator>
+void swap(PersistentBST<T, Compare, Allocator>& first, PersistentBST<T, Compare, Allocator>& second) {
+  first.swap(second);
+}
+
+} // bialger
+
+#endif //LIB_BST_PERSISTENTBST_HPP_
@@ -0,0 +1,93 @@
+#ifndef LIB_BST_PERSISTENTBSTITERATOR_HPP_
+#define LIB_BST_PERSISTENTBSTITERATOR_HPP_
+
+#include <iterator>
+#include <stdexcept>
+
+#include "lib/tree/PersistentTree.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator>
+class PersistentBST;
+
+template<Allocable T, Comparator<T> Compare, AllocatorType Allocator>
+class PersistentBstIterator {
+ public:
+  friend class PersistentBST<T, Compare, Allocator>;
+
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = T;
+  using reference = const T&;
+  using const_reference = const T&;
+  using pointer = const T*;
+  using const_pointer = const T*;
+
+ private:
+  using TreeType = PersistentTree<T, Compare, Allocator>;
+  using NodeType = TreeType::NodeType;
+
+ public:
+  PersistentBstIterator() : current_(nullptr), tree_(nullptr) {}
+
+  PersistentBstIterator(const NodeType* node, const TreeType& tree) : current_(node), tree_(&tree) {}
+
+  const_reference operator*() const {
+    if (current_ == nullptr) {
+      throw std::out_of_range("Bad dereference attempt: *PersistentBST::end()");
+    }
+
+    return current_->key;
+  }
+
+  const_pointer operator->() const {
+    if (current_ == nullptr) {
+      throw std::out_of_range("Bad dereference attempt: PersistentBST::end()->");
+    }
+
+    return &current_->key;
+  }
+
+  PersistentBstIterator& operator++() {
+    if (current_ == nullptr) {
+      throw std::out_of_range("Bad incrementation attempt: ++PersistentBST::end()");
+    }
+
+    current_ = tree_->UpperBound(current_->key);
+    return *this;
+  }
+
+  PersistentBstIterator operator++(int) {
+    PersistentBstIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  PersistentBstIterator& operator--() {
+    current_ = (current_ == nullptr) ? tree_->GetLast() : tree_->Predecessor(current_->key);
+    return *this;
+  }
+
+  PersistentBstIterator operator--(int) {
+    PersistentBstIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const PersistentBstIterator& other) const {
+    return current_ == other.current_ && tree_ == other.tree_;
+  }
+
+  bool operator!=(const PersistentBstIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  const NodeType* current_;
+  const TreeType* tree_;
+};
+
+} // bialger
+
+#endif //LIB_BST_PERSISTENTBSTITERATOR_HPP_
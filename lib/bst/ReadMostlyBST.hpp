@@ -0,0 +1,126 @@
+#ifndef LIB_BST_READMOSTLYBST_HPP_
+#define LIB_BST_READMOSTLYBST_HPP_
+
+#include <optional>
+#include <stdexcept>
+
+#include "lib/tree/ReadMostlyTree.hpp"
+#include "BstConcepts.hpp"
+
+namespace bialger {
+
+template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+class ReadMostlyBST {
+  static_assert(std::is_same<typename std::remove_cv<T>::type, T>::value,
+                "bialger::ReadMostlyBST must have a non-const, non-volatile value_type");
+
+ protected:
+  using TreeType = ReadMostlyTree<T, Compare, Allocator>;
+
+ public:
+  using key_type = T;
+  using value_type = key_type;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  ReadMostlyBST() : tree_() {}
+
+  explicit ReadMostlyBST(const Compare& comp, const Allocator& alloc = Allocator()) : tree_(comp, alloc) {}
+
+  explicit ReadMostlyBST(const Allocator& alloc) : ReadMostlyBST(Compare(), alloc) {}
+
+  ReadMostlyBST(const std::initializer_list<T>& list,
+                 const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator()) : ReadMostlyBST(comp, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  ReadMostlyBST(const ReadMostlyBST& other) = delete;
+  ReadMostlyBST& operator=(const ReadMostlyBST& other) = delete;
+
+  bool insert(const T& key) {
+    if (tree_.GetComparator()(key, key)) {
+      throw std::invalid_argument("Incorrect template parameter Compare: is not strict");
+    }
+
+    return tree_.Insert(key);
+  }
+
+  template<InputIterator<T> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(const std::initializer_list<T>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  size_type erase(const T& key) {
+    return tree_.Delete(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] bool contains(const T& key) const {
+    return tree_.Contains(key);
+  }
+
+  [[nodiscard]] size_type count(const T& key) const {
+    return tree_.Contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] std::optional<T> find(const T& key) const {
+    std::optional<T> bound = tree_.LowerBound(key);
+
+    if (bound.has_value() && tree_.GetComparator()(key, *bound)) {
+      return std::nullopt;
+    }
+
+    return bound;
+  }
+
+  [[nodiscard]] std::optional<T> lower_bound(const T& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  [[nodiscard]] std::optional<T> upper_bound(const T& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  [[nodiscard]] size_type size() const {
+    return tree_.GetSize();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return tree_.GetSize() == 0;
+  }
+
+  void clear() {
+    tree_.Clear();
+  }
+
+  void reclaim() {
+    tree_.Reclaim();
+  }
+
+  template<typename Function>
+  void for_each(Function&& function) const {
+    tree_.TraverseInOrder(function);
+  }
+
+  allocator_type get_allocator() const {
+    return tree_.GetAllocator();
+  }
+
+  key_compare key_comp() const {
+    return tree_.GetComparator();
+  }
+
+ protected:
+  TreeType tree_;
+};
+
+} // bialger
+
+#endif //LIB_BST_READMOSTLYBST_HPP_
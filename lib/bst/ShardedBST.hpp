@@ -0,0 +1,607 @@
+#ifndef LIB_BST_SHARDEDBST_HPP_
+#define LIB_BST_SHARDEDBST_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "lib/tree/EpochReclaimer.hpp"
+#include "BST.hpp"
+
+namespace bialger {
+
+/* Set split into key-range shards, each a BST behind its own lock. Shard i
+ * holds the keys from its lower bound up to the lower bound of shard i + 1,
+ * so every operation locks a single shard and ordered scans walk the shards
+ * in turn. Point operations read the shard layout without a shared lock: the
+ * layout is an immutable snapshot published through an atomic pointer, read
+ * under an EpochGuard and validated again once the shard is locked. Layout
+ * changes lock every shard before publishing, so a stale route is always
+ * caught. A shard that grows past the average while shards are free, or past
+ * twice the average once all are in use, is split at its median, merging the
+ * lightest adjacent pair to free a shard. */
+
+template<Allocable T, Comparator<T> Compare = std::less<>, AllocatorType Allocator = std::allocator<T>>
+class ShardedBST {
+ public:
+  using container_type = BST<T, Compare, Allocator>;
+  using key_type = T;
+  using value_type = key_type;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+
+  static constexpr size_type kDefaultShards = 16;
+
+  explicit ShardedBST(size_type shards = kDefaultShards,
+                      const Compare& comp = Compare(),
+                      const Allocator& alloc = Allocator())
+      : shards_(nullptr),
+        shard_count_(shards),
+        active_(1),
+        layout_(nullptr),
+        retired_head_(nullptr),
+        allocator_(alloc),
+        less_(comp) {
+    if (shards == 0) {
+      throw std::invalid_argument("ShardedBST must have at least one shard");
+    }
+
+    ShardAllocatorType shard_allocator(allocator_);
+    shards_ = ShardAllocatorTraits::allocate(shard_allocator, shard_count_);
+
+    for (size_type i = 0; i < shard_count_; ++i) {
+      ShardAllocatorTraits::construct(shard_allocator, shards_ + i, comp, alloc);
+    }
+
+    layout_.store(CreateLayout(), std::memory_order_release);
+  }
+
+  ShardedBST(const std::initializer_list<T>& list,
+             size_type shards = kDefaultShards,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator()) : ShardedBST(shards, comp, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  ShardedBST(const ShardedBST& other) = delete;
+  ShardedBST& operator=(const ShardedBST& other) = delete;
+
+  ~ShardedBST() {
+    DeleteLayout(layout_.load(std::memory_order_relaxed));
+    FreeRetired(EpochReclaimer::kIdle);
+    ShardAllocatorType shard_allocator(allocator_);
+
+    for (size_type i = 0; i < shard_count_; ++i) {
+      ShardAllocatorTraits::destroy(shard_allocator, shards_ + i);
+    }
+
+    ShardAllocatorTraits::deallocate(shard_allocator, shards_, shard_count_);
+  }
+
+  bool insert(const T& key) {
+    bool inserted = false;
+    bool skewed = WithShard<std::unique_lock<std::shared_mutex>>(key, [&](Shard& shard, const Layout& layout) {
+      inserted = shard.bst.insert(key).second;
+      size_type shard_size = shard.bst.size();
+      shard.size.store(shard_size, std::memory_order_relaxed);
+
+      return inserted && shard_size % kSkewCheckPeriod == 0 && IsSkewed(shard_size, size(), layout.active);
+    });
+
+    if (skewed) {
+      Split(key);
+    }
+
+    return inserted;
+  }
+
+  template<InputIterator<T> InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(const std::initializer_list<T>& list) {
+    insert(list.begin(), list.end());
+  }
+
+  size_type erase(const T& key) {
+    return WithShard<std::unique_lock<std::shared_mutex>>(key, [&](Shard& shard, const Layout&) {
+      size_type erased = shard.bst.erase(key);
+      shard.size.store(shard.bst.size(), std::memory_order_relaxed);
+
+      return erased;
+    });
+  }
+
+  void clear() {
+    ChangeLayout([&] {
+      for (size_type i = 0; i < active_; ++i) {
+        shards_[i].bst.clear();
+        shards_[i].lower.reset();
+        shards_[i].size.store(0, std::memory_order_relaxed);
+      }
+
+      active_ = 1;
+    });
+  }
+
+  [[nodiscard]] bool contains(const T& key) const {
+    return WithShard<std::shared_lock<std::shared_mutex>>(key, [&](const Shard& shard, const Layout&) {
+      return shard.bst.contains(key);
+    });
+  }
+
+  [[nodiscard]] size_type count(const T& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] std::optional<T> find(const T& key) const {
+    return WithShard<std::shared_lock<std::shared_mutex>>(key, [&](const Shard& shard, const Layout&) {
+      auto it = shard.bst.find(key);
+      return (it == shard.bst.cend()) ? std::nullopt : std::optional<T>(*it);
+    });
+  }
+
+  [[nodiscard]] std::optional<T> lower_bound(const T& key) const {
+    return Bound(key, [](const container_type& bst, const T& bound) {
+      return bst.lower_bound(bound);
+    });
+  }
+
+  [[nodiscard]] std::optional<T> upper_bound(const T& key) const {
+    return Bound(key, [](const container_type& bst, const T& bound) {
+      return bst.upper_bound(bound);
+    });
+  }
+
+  /* Visits the keys in order. Each shard is copied out under its shared lock
+   * and the function runs with no lock held, so it may modify the container.
+   * A layout change between two shards restarts the walk from the lower
+   * bound of the next shard. */
+
+  template<typename Function>
+  void for_each(Function&& function) const {
+    EpochGuard guard;
+    std::optional<T> from;
+
+    while (true) {
+      const Layout* layout = layout_.load(std::memory_order_acquire);
+      bool valid = true;
+
+      for (size_type i = from.has_value() ? Route(*layout, *from) : 0; valid && i < layout->active; ++i) {
+        size_type total = 0;
+        T* keys = nullptr;
+
+        {
+          std::shared_lock lock(shards_[i].mutex);
+          valid = layout_.load(std::memory_order_acquire) == layout;
+
+          if (!valid) {
+            break;
+          }
+
+          keys = Collect(i, i + 1, total);
+        }
+
+        T* key = from.has_value() ? std::lower_bound(keys, keys + total, *from, less_) : keys;
+
+        try {
+          for (; key != keys + total; ++key) {
+            function(*key);
+          }
+        } catch (...) {
+          Release(keys, total);
+          throw;
+        }
+
+        Release(keys, total);
+
+        if (i + 1 < layout->active) {
+          from = layout->lowers[i];
+        }
+      }
+
+      if (valid) {
+        return;
+      }
+    }
+  }
+
+  [[nodiscard]] container_type snapshot() const {
+    EpochGuard guard;
+    const Layout* layout = layout_.load(std::memory_order_acquire);
+
+    while (true) {
+      for (size_type i = 0; i < layout->active; ++i) {
+        shards_[i].mutex.lock_shared();
+      }
+
+      const Layout* current = layout_.load(std::memory_order_acquire);
+
+      if (current == layout) {
+        break;
+      }
+
+      UnlockShared(layout->active);
+      layout = current;
+    }
+
+    size_type total = 0;
+    T* keys = nullptr;
+
+    try {
+      keys = Collect(0, layout->active, total);
+    } catch (...) {
+      UnlockShared(layout->active);
+      throw;
+    }
+
+    UnlockShared(layout->active);
+    container_type result(keys, keys + total, less_, allocator_);
+    Release(keys, total);
+
+    return result;
+  }
+
+  void rebalance() {
+    ChangeLayout([&] {
+      Redistribute(0, active_, shard_count_);
+    });
+  }
+
+  [[nodiscard]] size_type size() const {
+    size_type total = 0;
+
+    for (size_type i = 0; i < shard_count_; ++i) {
+      total += shards_[i].size.load(std::memory_order_relaxed);
+    }
+
+    return total;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return size() == 0;
+  }
+
+  [[nodiscard]] size_type shard_count() const {
+    return shard_count_;
+  }
+
+  [[nodiscard]] size_type shard_size(size_type index) const {
+    return (index < shard_count_) ? shards_[index].size.load(std::memory_order_relaxed) : 0;
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_;
+  }
+
+  key_compare key_comp() const {
+    return less_;
+  }
+
+ protected:
+  struct Shard {
+    container_type bst;
+    std::optional<T> lower;
+    std::atomic<size_type> size;
+    mutable std::shared_mutex mutex;
+
+    Shard(const Compare& comp, const Allocator& alloc) : bst(comp, alloc), lower(), size(0), mutex() {}
+  };
+
+  // Lower bounds of shards 1 .. active - 1; shard 0 starts below every key.
+  struct Layout {
+    size_type active;
+    T* lowers;
+    Layout* retired_next;
+    uint64_t retired_epoch;
+  };
+
+  using ShardAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Shard>;
+  using ShardAllocatorTraits = std::allocator_traits<ShardAllocatorType>;
+  using LayoutAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Layout>;
+  using LayoutAllocatorTraits = std::allocator_traits<LayoutAllocatorType>;
+  using KeyAllocatorTraits = std::allocator_traits<Allocator>;
+
+  static constexpr size_type kRebalanceSlack = 1024;
+  static constexpr size_type kSkewCheckPeriod = 64;
+
+  Shard* shards_;
+  size_type shard_count_;
+  size_type active_;
+  std::atomic<Layout*> layout_;
+  Layout* retired_head_;
+  Allocator allocator_;
+  Compare less_;
+  std::mutex layout_mutex_;
+
+  size_type Route(const Layout& layout, const T& key) const {
+    size_type first = 0;
+    size_type last = layout.active - 1;
+
+    while (first < last) {
+      size_type middle = first + (last - first) / 2;
+
+      if (less_(key, layout.lowers[middle])) {
+        last = middle;
+      } else {
+        first = middle + 1;
+      }
+    }
+
+    return first;
+  }
+
+  template<typename Lock, typename Function>
+  auto WithShard(const T& key, Function function) const {
+    EpochGuard guard;
+
+    while (true) {
+      const Layout* layout = layout_.load(std::memory_order_acquire);
+      Shard& shard = shards_[Route(*layout, key)];
+      Lock lock(shard.mutex);
+
+      if (layout_.load(std::memory_order_acquire) == layout) {
+        return function(shard, *layout);
+      }
+    }
+  }
+
+  // The shard check is only run every kSkewCheckPeriod inserts, so the limit
+  // is lowered by one period to split no later than an exact check would.
+  bool IsSkewed(size_type shard_size, size_type total, size_type active) const {
+    size_type limit = (active < shard_count_) ? total / shard_count_ : 2 * (total / shard_count_);
+    return shard_count_ > 1 && shard_size + kSkewCheckPeriod > limit + kRebalanceSlack;
+  }
+
+  template<typename BoundFunction>
+  std::optional<T> Bound(const T& key, BoundFunction bound) const {
+    EpochGuard guard;
+
+    while (true) {
+      const Layout* layout = layout_.load(std::memory_order_acquire);
+      bool valid = true;
+
+      for (size_type i = Route(*layout, key); valid && i < layout->active; ++i) {
+        std::shared_lock lock(shards_[i].mutex);
+        valid = layout_.load(std::memory_order_acquire) == layout;
+
+        if (valid) {
+          auto it = bound(shards_[i].bst, key);
+
+          if (it != shards_[i].bst.cend()) {
+            return *it;
+          }
+        }
+      }
+
+      if (valid) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  void Split(const T& key) {
+    ChangeLayout([&] {
+      size_type index = Route(*layout_.load(std::memory_order_relaxed), key);
+
+      if (!IsSkewed(shards_[index].bst.size(), size(), active_)) {
+        return;
+      }
+
+      if (active_ == shard_count_) {
+        size_type lightest = active_;
+
+        for (size_type i = 0; i + 1 < active_; ++i) {
+          if (i != index && i + 1 != index
+              && (lightest == active_ || shards_[i].bst.size() + shards_[i + 1].bst.size()
+                  < shards_[lightest].bst.size() + shards_[lightest + 1].bst.size())) {
+            lightest = i;
+          }
+        }
+
+        if (lightest == active_
+            || shards_[lightest].bst.size() + shards_[lightest + 1].bst.size() > size() / shard_count_) {
+          Redistribute(0, active_, shard_count_);
+          return;
+        }
+
+        Redistribute(lightest, lightest + 2, 1);
+        index -= (lightest < index) ? 1 : 0;
+      }
+
+      Redistribute(index, index + 1, 2);
+    });
+  }
+
+  /* Runs a layout change with every shard locked, then publishes the new
+   * layout before the shards are released: a point operation that routed
+   * with the old layout sees the new pointer once it gets its shard lock. */
+
+  template<typename Change>
+  void ChangeLayout(Change change) {
+    std::unique_lock layout(layout_mutex_);
+
+    for (size_type i = 0; i < shard_count_; ++i) {
+      shards_[i].mutex.lock();
+    }
+
+    try {
+      change();
+      Layout* previous = layout_.exchange(CreateLayout(), std::memory_order_acq_rel);
+      Retire(previous);
+    } catch (...) {
+      Unlock();
+      throw;
+    }
+
+    Unlock();
+  }
+
+  void Unlock() const {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      shards_[i].mutex.unlock();
+    }
+  }
+
+  void UnlockShared(size_type count) const {
+    for (size_type i = 0; i < count; ++i) {
+      shards_[i].mutex.unlock_shared();
+    }
+  }
+
+  Layout* CreateLayout() {
+    LayoutAllocatorType layout_allocator(allocator_);
+    Layout* layout = LayoutAllocatorTraits::allocate(layout_allocator, 1);
+    T* lowers = nullptr;
+    size_type filled = 0;
+
+    try {
+      lowers = KeyAllocatorTraits::allocate(allocator_, active_ - 1);
+
+      for (; filled + 1 < active_; ++filled) {
+        KeyAllocatorTraits::construct(allocator_, lowers + filled, *shards_[filled + 1].lower);
+      }
+    } catch (...) {
+      if (lowers != nullptr) {
+        for (size_type i = 0; i < filled; ++i) {
+          KeyAllocatorTraits::destroy(allocator_, lowers + i);
+        }
+
+        KeyAllocatorTraits::deallocate(allocator_, lowers, active_ - 1);
+      }
+
+      LayoutAllocatorTraits::deallocate(layout_allocator, layout, 1);
+      throw;
+    }
+
+    layout->active = active_;
+    layout->lowers = lowers;
+    layout->retired_next = nullptr;
+    layout->retired_epoch = 0;
+
+    return layout;
+  }
+
+  void DeleteLayout(Layout* layout) {
+    LayoutAllocatorType layout_allocator(allocator_);
+    Release(layout->lowers, layout->active - 1);
+    LayoutAllocatorTraits::deallocate(layout_allocator, layout, 1);
+  }
+
+  void Retire(Layout* layout) {
+    layout->retired_epoch = EpochReclaimer::GetRetireEpoch();
+    layout->retired_next = retired_head_;
+    retired_head_ = layout;
+    FreeRetired(EpochReclaimer::GetSafeEpoch());
+  }
+
+  void FreeRetired(uint64_t safe_epoch) {
+    Layout** link = &retired_head_;
+
+    while (*link != nullptr) {
+      Layout* layout = *link;
+
+      if (layout->retired_epoch < safe_epoch) {
+        *link = layout->retired_next;
+        DeleteLayout(layout);
+      } else {
+        link = &layout->retired_next;
+      }
+    }
+  }
+
+  // Callers hold the locks of the shards in [first, last).
+  T* Collect(size_type first, size_type last, size_type& total) const {
+    Allocator allocator = allocator_;
+    total = 0;
+
+    for (size_type i = first; i < last; ++i) {
+      total += shards_[i].bst.size();
+    }
+
+    T* keys = KeyAllocatorTraits::allocate(allocator, total);
+    size_type filled = 0;
+
+    for (size_type i = first; i < last; ++i) {
+      for (const T& key : shards_[i].bst) {
+        KeyAllocatorTraits::construct(allocator, keys + filled++, key);
+      }
+    }
+
+    return keys;
+  }
+
+  void Release(T* keys, size_type total) const {
+    Allocator allocator = allocator_;
+
+    for (size_type i = 0; i < total; ++i) {
+      KeyAllocatorTraits::destroy(allocator, keys + i);
+    }
+
+    KeyAllocatorTraits::deallocate(allocator, keys, total);
+  }
+
+  // Runs with every shard locked, so the new shards are built on this thread.
+  void Redistribute(size_type first, size_type last, size_type count) {
+    size_type total = 0;
+    T* keys = Collect(first, last, total);
+    count = std::max<size_type>(1, std::min(count, total));
+    std::optional<T> lower = std::move(shards_[first].lower);
+
+    for (size_type i = first; i < last; ++i) {
+      shards_[i].bst.clear();
+      shards_[i].size.store(0, std::memory_order_relaxed);
+    }
+
+    Shift(last, first + count);
+
+    for (size_type k = 0; k < count; ++k) {
+      size_type begin = total * k / count;
+      size_type end = total * (k + 1) / count;
+      Shard& shard = shards_[first + k];
+
+      shard.bst = container_type(keys + begin, keys + end, less_, allocator_, 1);
+      shard.lower = (k == 0) ? std::move(lower) : std::optional<T>(keys[begin]);
+      shard.size.store(end - begin, std::memory_order_relaxed);
+    }
+
+    Release(keys, total);
+  }
+
+  void Shift(size_type from, size_type to) {
+    size_type moved = active_ - from;
+
+    if (to > from) {
+      for (size_type i = moved; i > 0; --i) {
+        MoveShard(from + i - 1, to + i - 1);
+      }
+    } else if (to < from) {
+      for (size_type i = 0; i < moved; ++i) {
+        MoveShard(from + i, to + i);
+      }
+    }
+
+    active_ = active_ - from + to;
+  }
+
+  void MoveShard(size_type from, size_type to) {
+    shards_[to].bst = std::move(shards_[from].bst);
+    shards_[to].lower = std::move(shards_[from].lower);
+    shards_[to].size.store(shards_[from].size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    shards_[from].lower.reset();
+    shards_[from].size.store(0, std::memory_order_relaxed);
+  }
+};
+
+} // bialger
+
+#endif //LIB_BST_SHARDEDBST_HPP_
@@ -1,13 +1,22 @@
 #ifndef LIB_TREE_BINARYSEARCHTREE_HPP_
 #define LIB_TREE_BINARYSEARCHTREE_HPP_
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <cstdint>
+#include <optional>
+#include <thread>
 #include <type_traits>
 
 #include "ITemplateTree.hpp"
 #include "TreeNode.hpp"
 #include "TreeConcepts.hpp"
+#include "TreeAugmentation.hpp"
 #include "PreOrder.hpp"
 #include "InOrder.hpp"
 #include "PostOrder.hpp"
@@ -40,14 +49,17 @@ struct Equivalent<void, Compare> {
   Compare comparator_{};
 };
 
-template<Allocable T, typename U, Comparator<T> Less, AllocatorType Allocator>
-class BinarySearchTree : public ITemplateTree<T, U> {
+template<Allocable T, typename U, Comparator<T> Less, AllocatorType Allocator,
+    AugmentationType<T> Augmentation = NoAugmentation>
+class BinarySearchTree : public ITemplateTree<T, U, typename Augmentation::value_type> {
  public:
   using Equals = Equivalent<void, Less>;
-  using TreeInterface = ITemplateTree<T, U>;
-  using NodeType = TreeNode<T, U>;
+  using aggregate_type = typename Augmentation::value_type;
+  using TreeInterface = ITemplateTree<T, U, aggregate_type>;
+  using NodeType = TreeNode<T, U, aggregate_type>;
   using key_type = T;
   using value_type = U;
+  using NodeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType>;
 
   explicit BinarySearchTree(bool allow_duplicates = false,
                             const Less& less = Less(),
@@ -61,9 +73,7 @@ class BinarySearchTree : public ITemplateTree<T, U> {
         allow_duplicates_(other.allow_duplicates_),
         less_(other.less_),
         size_{} {
-    other.Traverse<PreOrder>([&](const NodeType* current) {
-      this->Insert(current->key, current->value);
-    });
+    root_ = Clone(other.root_);
   }
 
   BinarySearchTree& operator=(const BinarySearchTree& other) {
@@ -76,9 +86,7 @@ class BinarySearchTree : public ITemplateTree<T, U> {
     node_allocator_ = other.node_allocator_;
 
     Clear();
-    other.Traverse<PreOrder>([&](const NodeType* current) {
-      this->Insert(current->key, current->value);
-    });
+    root_ = Clone(other.root_);
 
     return *this;
   }
@@ -132,60 +140,236 @@ class BinarySearchTree : public ITemplateTree<T, U> {
     return result;
   }
 
+  template<typename... Args>
+  std::pair<NodeType*, bool> TryEmplace(const T& key, Args&& ... args) {
+    return TryEmplaceFrom(root_, key, std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  std::pair<NodeType*, bool> TryEmplaceFrom(NodeType* finger, const T& key, Args&& ... args) {
+    NodeType* current = ClimbToCover(finger, key);
+    NodeType* parent = (current == nullptr) ? nullptr : current->parent;
+    bool is_left = false;
+
+    while (current != nullptr) {
+      if (AreEqual(key, current->key) && !allow_duplicates_) {
+        return {current, false};
+      }
+
+      parent = current;
+      is_left = less_(key, current->key) || (allow_duplicates_ && AreEqual(key, current->key));
+      current = is_left ? current->left : current->right;
+    }
+
+    NodeType* new_node = CreateNode(key, U(std::forward<Args>(args)...));
+    LinkNode(parent, new_node, is_left);
+    return {new_node, true};
+  }
+
   void Delete(NodeType* node) override {
     if (node == nullptr || node == end_) {
       return;
     }
 
-    if (node->HasLeft() && node->HasRight()) {
-      NodeType* min = GetMin(node->right);
-      SwapNodes(node, min);
-      Delete(node);
-    } else if (node->HasLeft()) {
-      NodeType* left = node->left;
-      NodeType* parent = node->parent;
+    Unlink(node);
+    DeleteNode(node);
+  }
 
-      if (node == root_) {
-        root_ = left;
-        left->parent = nullptr;
-      } else if (parent->left == node) {
-        parent->left = left;
-        left->parent = parent;
-      } else {
-        parent->right = left;
-        left->parent = parent;
+  NodeType* Extract(NodeType* node) {
+    if (node == nullptr || node == end_) {
+      return nullptr;
+    }
+
+    Unlink(node);
+    --size_;
+    node->parent = nullptr;
+    node->left = nullptr;
+    node->right = nullptr;
+
+    return node;
+  }
+
+  std::pair<NodeType*, bool> InsertNode(NodeType* node) {
+    NodeType* parent = nullptr;
+    NodeType* current = root_;
+    bool is_left = false;
+
+    while (current != nullptr) {
+      if (AreEqual(node->key, current->key) && !allow_duplicates_) {
+        return {current, false};
       }
 
-      DeleteNode(node);
-    } else if (node->HasRight()) {
-      NodeType* right = node->right;
-      NodeType* parent = node->parent;
+      parent = current;
+      is_left = less_(node->key, current->key) || (allow_duplicates_ && AreEqual(node->key, current->key));
+      current = is_left ? current->left : current->right;
+    }
 
-      if (node == root_) {
-        root_ = right;
-        right->parent = nullptr;
-      } else if (parent->left == node) {
-        parent->left = right;
-        right->parent = parent;
-      } else {
-        parent->right = right;
-        right->parent = parent;
+    ++size_;
+    LinkNode(parent, node, is_left);
+    return {node, true};
+  }
+
+  void DeleteRange(NodeType* first, NodeType* last) {
+    if (first == nullptr || first == end_ || first == last) {
+      return;
+    }
+
+    const T lo = first->key;
+    const T* hi = (last == nullptr || last == end_) ? nullptr : &last->key;
+    root_ = DeleteRange(root_, lo, hi, true, hi != nullptr);
+
+    if (root_ != nullptr) {
+      root_->parent = nullptr;
+    }
+  }
+
+  void Merge(BinarySearchTree& other) {
+    if (this == &other || other.root_ == nullptr) {
+      return;
+    }
+
+    NodeType* rejected = nullptr;
+    size_t rejected_size = 0;
+
+    if (!(node_allocator_ == other.node_allocator_)) {
+      // The nodes have to be copied; other keeps the unprocessed rest if a copy throws.
+      NodeType* list = Flatten(other.root_);
+      NodeType** rejected_tail = &rejected;
+      size_t remaining = other.size_;
+      other.root_ = nullptr;
+      other.size_ = 0;
+
+      try {
+        while (list != nullptr) {
+          bool inserted = TryEmplace(list->key, list->value).second;
+          NodeType* node = list;
+          list = list->right;
+
+          if (inserted) {
+            --remaining;
+            other.FreeNode(node);
+          } else {
+            *rejected_tail = node;
+            rejected_tail = &node->right;
+            ++rejected_size;
+          }
+        }
+      } catch (...) {
+        *rejected_tail = list;
+        other.size_ = remaining;
+        other.root_ = BuildBalanced(rejected, remaining);
+        throw;
       }
 
-      DeleteNode(node);
-    } else {
-      NodeType* parent = node->parent;
+      *rejected_tail = nullptr;
+      other.size_ = rejected_size;
+      other.root_ = BuildBalanced(rejected, rejected_size);
+      return;
+    }
 
-      if (node == root_) {
-        root_ = end_;
-      } else if (parent->left == node) {
-        parent->left = nullptr;
-      } else {
-        parent->right = nullptr;
+    if (other.size_ * std::bit_width(size_) < size_ + other.size_) {
+      NodeType* list = Flatten(other.root_);
+      NodeType** rejected_tail = &rejected;
+
+      while (list != nullptr) {
+        NodeType* node = list;
+        list = list->right;
+        node->right = nullptr;
+
+        if (!InsertNode(node).second) {
+          *rejected_tail = node;
+          rejected_tail = &node->right;
+          ++rejected_size;
+        }
       }
 
-      DeleteNode(node);
+      *rejected_tail = nullptr;
+      other.size_ = rejected_size;
+      other.root_ = BuildBalanced(rejected, rejected_size);
+      return;
     }
+
+    size_t total_size = size_ + other.size_;
+    NodeType* merged = MergeLists(Flatten(root_), Flatten(other.root_), rejected, rejected_size);
+
+    size_ = total_size - rejected_size;
+    root_ = BuildBalanced(merged, size_);
+    other.size_ = rejected_size;
+    other.root_ = BuildBalanced(rejected, rejected_size);
+  }
+
+  void AssignSetOperation(const BinarySearchTree& lhs, const BinarySearchTree& rhs,
+                          bool keep_lhs, bool keep_common, bool keep_rhs) {
+    NodeType* head = nullptr;
+    NodeType** tail = &head;
+    const NodeType* lhs_node = GetMin(lhs.root_);
+    const NodeType* rhs_node = GetMin(rhs.root_);
+
+    auto append = [&](const NodeType* node) {
+      *tail = CreateNode(node->key, node->value);
+      tail = &(*tail)->right;
+    };
+
+    // The result is built aside and only replaces the contents once complete.
+    auto build = [&] {
+      while (lhs_node != nullptr && rhs_node != nullptr) {
+        if (less_(lhs_node->key, rhs_node->key)) {
+          if (keep_lhs) {
+            append(lhs_node);
+          }
+
+          lhs_node = GetNext(lhs_node);
+        } else if (less_(rhs_node->key, lhs_node->key)) {
+          if (keep_rhs) {
+            append(rhs_node);
+          }
+
+          rhs_node = GetNext(rhs_node);
+        } else {
+          if (keep_common) {
+            append(lhs_node);
+          }
+
+          lhs_node = GetNext(lhs_node);
+          rhs_node = GetNext(rhs_node);
+        }
+      }
+
+      for (; keep_lhs && lhs_node != nullptr; lhs_node = GetNext(lhs_node)) {
+        append(lhs_node);
+      }
+
+      for (; keep_rhs && rhs_node != nullptr; rhs_node = GetNext(rhs_node)) {
+        append(rhs_node);
+      }
+    };
+
+    try {
+      build();
+    } catch (...) {
+      while (head != nullptr) {
+        NodeType* node = head;
+        head = head->right;
+        DeleteNode(node);
+      }
+
+      throw;
+    }
+
+    // Clear() takes the old nodes back out of size_, leaving the new count.
+    Clear();
+    root_ = BuildBalanced(head, size_);
+  }
+
+  bool DeleteKey(const T& key) {
+    NodeType* node = FindFirst(root_, key);
+
+    if (node == nullptr) {
+      return false;
+    }
+
+    Delete(node);
+    return true;
   }
 
   [[nodiscard]] NodeType* FindFirst(const T& key) const override {
@@ -196,6 +380,21 @@ class BinarySearchTree : public ITemplateTree<T, U> {
     return FindNextByKey(root_, key);
   }
 
+  [[nodiscard]] NodeType* FindFirstFrom(NodeType* finger, const T& key) const {
+    return FindFirst(ClimbToCover(finger, key), key);
+  }
+
+  [[nodiscard]] NodeType* LowerBoundFrom(NodeType* finger, const T& key) const {
+    NodeType* cover = ClimbToCover(finger, key);
+    NodeType* bound = LowerBound(cover, key);
+
+    if (bound == nullptr && cover != nullptr && cover->parent != nullptr && cover == cover->parent->left) {
+      return cover->parent;
+    }
+
+    return bound;
+  }
+
   [[nodiscard]] bool Contains(const T& key) const override {
     return FindFirst(key) != nullptr;
   }
@@ -215,14 +414,283 @@ class BinarySearchTree : public ITemplateTree<T, U> {
     return FindFirst(key) != nullptr;
   }
 
-  template<Traversable Traversal>
-  void Traverse(const std::function<void(const NodeType*)>& callback) const {
-    Traverse<Traversal>(root_, callback);
+  template<typename InputIt>
+  void InsertSorted(InputIt first, InputIt last) {
+    NodeType* finger = nullptr;
+
+    for (; first != last; ++first) {
+      finger = TryEmplaceFrom(finger, *first).first;
+    }
+  }
+
+  // Keys must be sorted; duplicates and keys already present are skipped. The
+  // keys that fall into one empty slot are linked there as a balanced subtree,
+  // so appending sorted batches does not grow a chain.
+  template<std::random_access_iterator RandomIt>
+  void InsertSortedRuns(RandomIt first, RandomIt last) {
+    NodeType* finger = nullptr;
+
+    while (first != last) {
+      NodeType* current = ClimbToCover(finger, *first);
+      NodeType* parent = (current == nullptr) ? nullptr : current->parent;
+      bool is_left = false;
+
+      while (current != nullptr && !AreEqual(*first, current->key)) {
+        parent = current;
+        is_left = less_(*first, current->key);
+        current = is_left ? current->left : current->right;
+      }
+
+      if (current != nullptr) {
+        finger = current;
+        ++first;
+        continue;
+      }
+
+      const NodeType* next = (parent == nullptr || is_left) ? parent : GetNext(parent);
+      RandomIt run_end = (next == nullptr) ? last : std::lower_bound(first, last, next->key, less_);
+      NodeType* head = nullptr;
+      NodeType** tail = &head;
+      NodeType* previous = nullptr;
+      size_t run_size = 0;
+
+      for (; first != run_end; ++first) {
+        if (previous == nullptr || less_(previous->key, *first)) {
+          previous = CreateNode(*first, U());
+          *tail = previous;
+          tail = &previous->right;
+          ++run_size;
+        }
+      }
+
+      *tail = nullptr;
+      LinkNode(parent, BuildBalanced(head, run_size), is_left);
+      finger = previous;
+    }
+  }
+
+  template<std::forward_iterator ForwardIt>
+  void BuildFrom(ForwardIt first, ForwardIt last, size_t threads = std::thread::hardware_concurrency()) {
+    if (root_ != nullptr) {
+      for (; first != last; ++first) {
+        Insert(*first, U());
+      }
+
+      return;
+    }
+
+    size_t count = std::distance(first, last);
+
+    if (count == 0) {
+      return;
+    }
+
+    NodeBuffer buffer(*this, count);
+    NodeType** nodes = buffer.nodes;
+
+    for (; buffer.created < count; ++buffer.created, ++first) {
+      nodes[buffer.created] = CreateNode(*first, U());
+    }
+
+    buffer.created = 0;
+    threads = std::clamp<size_t>(count / kParallelGrain, 1, std::max<size_t>(threads, 1));
+
+    auto by_key = [this](const NodeType* lhs, const NodeType* rhs) {
+      return less_(lhs->key, rhs->key);
+    };
+
+    if (!std::is_sorted(nodes, nodes + count, by_key)) {
+      SortNodes(nodes, count, threads, by_key);
+    }
+
+    size_t unique_count = count;
+
+    if (!allow_duplicates_) {
+      unique_count = 1;
+
+      for (size_t i = 1; i < count; ++i) {
+        if (less_(nodes[unique_count - 1]->key, nodes[i]->key)) {
+          nodes[unique_count++] = nodes[i];
+        } else {
+          DeleteNode(nodes[i]);
+        }
+      }
+    }
+
+    root_ = BuildBalanced(nodes, unique_count, threads);
+  }
+
+  // Morris in-order walk: reads no parent links and keeps no stack, but threads
+  // right links while it runs, so it needs the tree to itself. Once the
+  // callback stops or throws, the walk goes on without it to undo the threads.
+  template<typename Function>
+  bool TraverseThreaded(Function&& callback) {
+    bool proceed = true;
+    std::exception_ptr error;
+    NodeType* node = root_;
+    auto visit = [&](const NodeType* current) {
+      if (!proceed) {
+        return;
+      }
+
+      try {
+        proceed = Visit(callback, current);
+      } catch (...) {
+        error = std::current_exception();
+        proceed = false;
+      }
+    };
+
+    while (node != nullptr) {
+      if (node->left == nullptr) {
+        visit(node);
+        node = node->right;
+        continue;
+      }
+
+      NodeType* predecessor = node->left;
+
+      while (predecessor->right != nullptr && predecessor->right != node) {
+        predecessor = predecessor->right;
+      }
+
+      if (predecessor->right == nullptr) {
+        predecessor->right = node;
+        node = node->left;
+      } else {
+        predecessor->right = nullptr;
+        visit(node);
+        node = node->right;
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+
+    return proceed;
+  }
+
+  template<typename Function>
+  void ParallelForEach(Function&& function, size_t threads = std::thread::hardware_concurrency()) const {
+    if (size_ < kParallelSerialSize || threads <= 1) {
+      Traverse<InOrder>(root_, function);
+      return;
+    }
+
+    ParallelTask tasks[kParallelTasks];
+    size_t count = Decompose(tasks, threads);
+
+    RunParallel(count, threads, [&](size_t i) {
+      if (tasks[i].whole_subtree) {
+        Traverse<InOrder>(tasks[i].node, function);
+      } else {
+        function(tasks[i].node);
+      }
+    });
+  }
+
+  /* Works like std::transform_reduce: every key is mapped by transform and
+   * the results are folded into init with combine. Each task starts its
+   * partial result from the first mapped key of its range, and the partials
+   * are combined in key order, so combine has to be associative (not
+   * commutative) and accept both (R, transform result) and (R, R); R has to
+   * be constructible from the transform result. */
+
+  template<typename R, typename Combine, typename Transform = std::identity>
+  R ParallelReduce(R init,
+                   Combine combine,
+                   Transform transform = {},
+                   size_t threads = std::thread::hardware_concurrency()) const {
+    if (size_ < kParallelSerialSize || threads <= 1) {
+      Traverse<InOrder>(root_, [&](const NodeType* node) {
+        init = combine(std::move(init), transform(node->key));
+      });
+
+      return init;
+    }
+
+    ParallelTask tasks[kParallelTasks];
+    std::optional<R> partials[kParallelTasks];
+    size_t count = Decompose(tasks, threads);
+
+    RunParallel(count, threads, [&](size_t i) {
+      std::optional<R>& partial = partials[i];
+      auto fold = [&](const NodeType* node) {
+        if (partial.has_value()) {
+          partial = combine(std::move(*partial), transform(node->key));
+        } else {
+          partial.emplace(transform(node->key));
+        }
+      };
+
+      if (tasks[i].whole_subtree) {
+        Traverse<InOrder>(tasks[i].node, fold);
+      } else {
+        fold(tasks[i].node);
+      }
+    });
+
+    for (size_t i = 0; i < count; ++i) {
+      init = combine(std::move(init), std::move(*partials[i]));
+    }
+
+    return init;
+  }
+
+  template<typename Output>
+  void FindBatch(const T* keys, size_t count, Output&& output) const {
+    size_t lanes[kBatchLanes];
+    NodeType* cursors[kBatchLanes];
+    size_t active = 0;
+    size_t next = 0;
+
+    Prefetch(root_);
+
+    for (; active < kBatchLanes && next < count; ++active, ++next) {
+      lanes[active] = next;
+      cursors[active] = root_;
+    }
+
+    while (active > 0) {
+      for (size_t lane = 0; lane < active;) {
+        NodeType* node = cursors[lane];
+        const T& key = keys[lanes[lane]];
+
+        if (node != nullptr && (less_(key, node->key) || less_(node->key, key))) {
+          cursors[lane] = less_(key, node->key) ? node->left : node->right;
+          Prefetch(cursors[lane]);
+          ++lane;
+          continue;
+        }
+
+        output(lanes[lane], node);
+
+        if (next < count) {
+          lanes[lane] = next++;
+          cursors[lane] = root_;
+          ++lane;
+        } else {
+          --active;
+          lanes[lane] = lanes[active];
+          cursors[lane] = cursors[active];
+        }
+      }
+    }
   }
 
-  template<Traversable Traversal>
-  void Traverse(const std::function<void(NodeType*)>& callback) {
-    Traverse<Traversal>(root_, callback);
+  [[nodiscard]] aggregate_type Aggregate(const T& lo, const T& hi) const {
+    return Aggregate(root_, lo, hi, true, true);
+  }
+
+  template<Traversable Traversal, typename Function>
+  bool Traverse(Function&& callback) const {
+    return Traverse<Traversal, const NodeType>(root_, callback);
+  }
+
+  template<Traversable Traversal, typename Function>
+  bool Traverse(Function&& callback) {
+    return Traverse<Traversal, NodeType>(root_, callback);
   }
 
   [[nodiscard]] ITreeNode* GetRoot() const override {
@@ -253,6 +721,10 @@ class BinarySearchTree : public ITemplateTree<T, U> {
     return Allocator(node_allocator_);
   }
 
+  [[nodiscard]] const NodeAllocatorType& GetNodeAllocator() const {
+    return node_allocator_;
+  }
+
   bool AreEqual(const T& lhs, const T& rhs) const requires EquallyComparable<T> {
     return (lhs == rhs) || equals_(lhs, rhs);
   }
@@ -276,9 +748,54 @@ class BinarySearchTree : public ITemplateTree<T, U> {
   }
 
  protected:
-  using NodeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType>;
   using NodeAllocatorTraits = std::allocator_traits<NodeAllocatorType>;
 
+  using PointerAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType*>;
+  using PointerAllocatorTraits = std::allocator_traits<PointerAllocatorType>;
+
+  static constexpr size_t kBatchLanes = 8;
+  static constexpr size_t kParallelGrain = 1 << 14;
+
+  // Scratch array of freshly created nodes: if creating one throws, the ones
+  // created so far are destroyed along with the array.
+  struct NodeBuffer {
+    BinarySearchTree& tree;
+    PointerAllocatorType allocator;
+    NodeType** nodes;
+    size_t capacity;
+    size_t created;
+
+    NodeBuffer(BinarySearchTree& tree, size_t capacity)
+        : tree(tree),
+          allocator(tree.node_allocator_),
+          nodes(PointerAllocatorTraits::allocate(allocator, capacity)),
+          capacity(capacity),
+          created(0) {}
+
+    NodeBuffer(const NodeBuffer& other) = delete;
+    NodeBuffer& operator=(const NodeBuffer& other) = delete;
+
+    ~NodeBuffer() {
+      for (size_t i = 0; i < created; ++i) {
+        tree.DeleteNode(nodes[i]);
+      }
+
+      PointerAllocatorTraits::deallocate(allocator, nodes, capacity);
+    }
+  };
+  static constexpr size_t kParallelSerialSize = 1 << 17;
+  static constexpr size_t kParallelDepth = 5;
+  static constexpr size_t kParallelRefineDepth = 3;
+  static constexpr size_t kParallelRefineTasks = (size_t{2} << kParallelRefineDepth) - 1;
+  static constexpr size_t kParallelRounds = 3;
+  static constexpr size_t kParallelTasks = 256;
+
+  struct ParallelTask {
+    const NodeType* node;
+    bool whole_subtree;
+    size_t size; // capped at the split target; 0 until counted
+  };
+
   bool allow_duplicates_;
   size_t size_;
   NodeType* end_;
@@ -289,16 +806,56 @@ class BinarySearchTree : public ITemplateTree<T, U> {
 
   NodeType* CreateNode(const T& key, const U& value) {
     NodeType* new_node = NodeAllocatorTraits::allocate(node_allocator_, 1);
-    NodeAllocatorTraits::construct(node_allocator_, new_node, key, value);
+
+    try {
+      NodeAllocatorTraits::construct(node_allocator_, new_node, key, value);
+    } catch (...) {
+      NodeAllocatorTraits::deallocate(node_allocator_, new_node, 1);
+      throw;
+    }
+
     ++size_;
 
     return new_node;
   }
 
+  NodeType* CreateNode(const T& key, U&& value) {
+    NodeType* new_node = NodeAllocatorTraits::allocate(node_allocator_, 1);
+
+    try {
+      NodeAllocatorTraits::construct(node_allocator_, new_node, key, std::move(value));
+    } catch (...) {
+      NodeAllocatorTraits::deallocate(node_allocator_, new_node, 1);
+      throw;
+    }
+
+    ++size_;
+
+    return new_node;
+  }
+
+  void LinkNode(NodeType* parent, NodeType* node, bool is_left) {
+    node->parent = parent;
+
+    if (parent == nullptr) {
+      root_ = node;
+    } else if (is_left) {
+      parent->left = node;
+    } else {
+      parent->right = node;
+    }
+
+    UpdatePath(node);
+  }
+
   void DeleteNode(NodeType* node) {
+    FreeNode(node);
+    --size_;
+  }
+
+  void FreeNode(NodeType* node) {
     NodeAllocatorTraits::destroy(node_allocator_, node);
     NodeAllocatorTraits::deallocate(node_allocator_, node, 1);
-    --size_;
   }
 
   virtual NodeType* Insert(NodeType* node, std::pair<NodeType*, bool>& result, const T& key, const U& value) {
@@ -306,6 +863,7 @@ class BinarySearchTree : public ITemplateTree<T, U> {
       NodeType* new_node = CreateNode(key, value);
       result.first = new_node;
       result.second = true;
+      UpdateAggregate(new_node);
 
       return new_node;
     }
@@ -322,9 +880,464 @@ class BinarySearchTree : public ITemplateTree<T, U> {
       node->right->parent = node;
     }
 
+    UpdateAggregate(node);
+    return node;
+  }
+
+  void Unlink(NodeType* node) {
+    if (node->HasLeft() && node->HasRight()) {
+      NodeType* min = GetMin(node->right);
+      SwapNodes(node, min);
+      Unlink(node);
+    } else if (node->HasLeft()) {
+      NodeType* left = node->left;
+      NodeType* parent = node->parent;
+
+      if (node == root_) {
+        root_ = left;
+        left->parent = nullptr;
+      } else if (parent->left == node) {
+        parent->left = left;
+        left->parent = parent;
+      } else {
+        parent->right = left;
+        left->parent = parent;
+      }
+
+      UpdatePath(parent);
+    } else if (node->HasRight()) {
+      NodeType* right = node->right;
+      NodeType* parent = node->parent;
+
+      if (node == root_) {
+        root_ = right;
+        right->parent = nullptr;
+      } else if (parent->left == node) {
+        parent->left = right;
+        right->parent = parent;
+      } else {
+        parent->right = right;
+        right->parent = parent;
+      }
+
+      UpdatePath(parent);
+    } else {
+      NodeType* parent = node->parent;
+
+      if (node == root_) {
+        root_ = end_;
+      } else if (parent->left == node) {
+        parent->left = nullptr;
+      } else {
+        parent->right = nullptr;
+      }
+
+      UpdatePath(parent);
+    }
+  }
+
+  NodeType* DeleteRange(NodeType* node, const T& lo, const T* hi, bool check_lo, bool check_hi) {
+    if (node == nullptr) {
+      return nullptr;
+    }
+
+    if (!check_lo && !check_hi) {
+      Traverse<PostOrder>(node, [&](NodeType* current) {
+        DeleteNode(current);
+      });
+
+      return nullptr;
+    }
+
+    if (check_lo && less_(node->key, lo)) {
+      SetRight(node, DeleteRange(node->right, lo, hi, check_lo, check_hi));
+      UpdateAggregate(node);
+      return node;
+    }
+
+    if (check_hi && !less_(node->key, *hi)) {
+      SetLeft(node, DeleteRange(node->left, lo, hi, check_lo, check_hi));
+      UpdateAggregate(node);
+      return node;
+    }
+
+    NodeType* left = DeleteRange(node->left, lo, hi, check_lo, false);
+    NodeType* right = DeleteRange(node->right, lo, hi, false, check_hi);
+    DeleteNode(node);
+
+    return Join(left, right);
+  }
+
+  NodeType* Join(NodeType* left, NodeType* right) {
+    if (left == nullptr) {
+      return right;
+    }
+
+    if (right == nullptr) {
+      return left;
+    }
+
+    left->parent = nullptr;
+    NodeType* max = GetMax(left);
+    SetRight(max, right);
+    UpdatePath(max);
+
+    return left;
+  }
+
+  // Copies the shape of the source subtree node by node, walking back up through
+  // parent links, so the copy is O(n) and needs no stack even for a chain.
+  NodeType* Clone(const NodeType* source) {
+    if (source == nullptr) {
+      return nullptr;
+    }
+
+    NodeType* root = CreateNode(source->key, source->value);
+    NodeType* copy = root;
+
+    while (true) {
+      if (source->left != nullptr && copy->left == nullptr) {
+        source = source->left;
+        SetLeft(copy, CreateNode(source->key, source->value));
+        copy = copy->left;
+      } else if (source->right != nullptr && copy->right == nullptr) {
+        source = source->right;
+        SetRight(copy, CreateNode(source->key, source->value));
+        copy = copy->right;
+      } else {
+        copy->aggregate = source->aggregate;
+
+        if (copy == root) {
+          return root;
+        }
+
+        source = source->parent;
+        copy = copy->parent;
+      }
+    }
+  }
+
+  static NodeType* Flatten(NodeType* node) {
+    NodeType* head = nullptr;
+    NodeType** tail = &head;
+
+    while (node != nullptr) {
+      if (node->HasLeft()) {
+        NodeType* left = node->left;
+        node->left = left->right;
+        left->right = node;
+        node = left;
+      } else {
+        *tail = node;
+        tail = &node->right;
+        node = node->right;
+      }
+    }
+
+    return head;
+  }
+
+  NodeType* MergeLists(NodeType* lhs, NodeType* rhs, NodeType*& rejected, size_t& rejected_size) const {
+    NodeType* head = nullptr;
+    NodeType** tail = &head;
+    NodeType** rejected_tail = &rejected;
+
+    while (lhs != nullptr && rhs != nullptr) {
+      if (less_(rhs->key, lhs->key) || (allow_duplicates_ && !less_(lhs->key, rhs->key))) {
+        *tail = rhs;
+        rhs = rhs->right;
+      } else if (less_(lhs->key, rhs->key)) {
+        *tail = lhs;
+        lhs = lhs->right;
+      } else {
+        *tail = lhs;
+        lhs = lhs->right;
+        *rejected_tail = rhs;
+        rejected_tail = &rhs->right;
+        rhs = rhs->right;
+        ++rejected_size;
+      }
+
+      tail = &(*tail)->right;
+    }
+
+    *tail = (lhs != nullptr) ? lhs : rhs;
+    *rejected_tail = nullptr;
+
+    return head;
+  }
+
+  static NodeType* BuildBalanced(NodeType*& list, size_t size) {
+    if (size == 0) {
+      return nullptr;
+    }
+
+    NodeType* left = BuildBalanced(list, size / 2);
+    NodeType* node = list;
+    list = list->right;
+
+    node->parent = nullptr;
+    SetLeft(node, left);
+    SetRight(node, BuildBalanced(list, size - size / 2 - 1));
+    UpdateAggregate(node);
+
+    return node;
+  }
+
+  template<typename NodeLess>
+  static void SortNodes(NodeType** nodes, size_t size, size_t threads, const NodeLess& by_key) {
+    if (threads == 1 || size < kParallelGrain) {
+      std::stable_sort(nodes, nodes + size, by_key);
+      return;
+    }
+
+    size_t middle = size / 2;
+    std::thread worker([&] {
+      SortNodes(nodes, middle, threads / 2, by_key);
+    });
+    SortNodes(nodes + middle, size - middle, threads - threads / 2, by_key);
+    worker.join();
+    std::inplace_merge(nodes, nodes + middle, nodes + size, by_key);
+  }
+
+  static NodeType* BuildBalanced(NodeType** nodes, size_t size, size_t threads) {
+    if (size == 0) {
+      return nullptr;
+    }
+
+    NodeType* node = nodes[size / 2];
+    NodeType* left = nullptr;
+    NodeType* right = nullptr;
+
+    if (threads == 1 || size < kParallelGrain) {
+      left = BuildBalanced(nodes, size / 2, 1);
+      right = BuildBalanced(nodes + size / 2 + 1, size - size / 2 - 1, 1);
+    } else {
+      std::thread worker([&] {
+        left = BuildBalanced(nodes, size / 2, threads / 2);
+      });
+      right = BuildBalanced(nodes + size / 2 + 1, size - size / 2 - 1, threads - threads / 2);
+      worker.join();
+    }
+
+    node->parent = nullptr;
+    SetLeft(node, left);
+    SetRight(node, right);
+    UpdateAggregate(node);
+
+    return node;
+  }
+
+  /* Cuts the tree kParallelDepth levels down, then counts the subtrees in
+   * parallel and cuts the ones above the target again, for a few rounds. A
+   * count stops once it passes the target, so no round walks more than about
+   * a node per key. The tasks stay in key order. Every cut of a chain only
+   * peels off kParallelRefineDepth nodes, so a very skewed subtree can still
+   * end up as one large task. */
+
+  size_t Decompose(ParallelTask* tasks, size_t threads) const {
+    threads = std::min(threads, kParallelTasks);
+    size_t target = std::max(size_ / (4 * threads), kParallelGrain);
+    size_t count = Cut(root_, kParallelDepth, tasks, 0);
+    ParallelTask pieces[kParallelTasks];
+
+    for (size_t round = 0; round < kParallelRounds; ++round) {
+      RunParallel(count, threads, [&](size_t i) {
+        if (tasks[i].size == 0) {
+          tasks[i].size = CountUpTo(tasks[i].node, target + 1);
+        }
+      });
+
+      size_t refined = 0;
+
+      for (size_t i = 0; i < count; ++i) {
+        if (tasks[i].size > target && refined + (count - i - 1) + kParallelRefineTasks <= kParallelTasks) {
+          refined = Cut(tasks[i].node, kParallelRefineDepth, pieces, refined);
+        } else {
+          pieces[refined++] = tasks[i];
+        }
+      }
+
+      if (refined == count) {
+        break;
+      }
+
+      std::copy(pieces, pieces + refined, tasks);
+      count = refined;
+    }
+
+    return count;
+  }
+
+  static size_t Cut(const NodeType* node, size_t depth, ParallelTask* tasks, size_t count) {
+    if (node == nullptr) {
+      return count;
+    }
+
+    if (depth == 0) {
+      tasks[count] = {node, true, 0};
+      return count + 1;
+    }
+
+    count = Cut(node->left, depth - 1, tasks, count);
+    tasks[count++] = {node, false, 1};
+    return Cut(node->right, depth - 1, tasks, count);
+  }
+
+  static size_t CountUpTo(const NodeType* node, size_t limit) {
+    size_t count = 0;
+
+    Traverse<PreOrder>(node, [&](const NodeType*) {
+      return ++count < limit;
+    });
+
+    return count;
+  }
+
+  template<typename Task>
+  void RunParallel(size_t count, size_t threads, const Task& task) const {
+    std::atomic<size_t> next = 0;
+    auto worker = [&] {
+      for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+           i = next.fetch_add(1, std::memory_order_relaxed)) {
+        task(i);
+      }
+    };
+
+    size_t helpers = std::min(std::max<size_t>(threads, 1), count) - 1;
+    std::thread workers[kParallelTasks];
+
+    for (size_t i = 0; i < helpers; ++i) {
+      workers[i] = std::thread(worker);
+    }
+
+    worker();
+
+    for (size_t i = 0; i < helpers; ++i) {
+      workers[i].join();
+    }
+  }
+
+  static const NodeType* GetNext(const NodeType* node) {
+    if (node->HasRight()) {
+      node = node->right;
+
+      while (node->HasLeft()) {
+        node = node->left;
+      }
+
+      return node;
+    }
+
+    while (node->parent != nullptr && node == node->parent->right) {
+      node = node->parent;
+    }
+
+    return node->parent;
+  }
+
+  NodeType* ClimbToCover(NodeType* node, const T& key) const {
+    if (node == nullptr) {
+      return root_;
+    }
+
+    if (less_(node->key, key)) {
+      while (node->parent != nullptr && !(node == node->parent->left && less_(key, node->parent->key))) {
+        node = node->parent;
+      }
+    } else if (less_(key, node->key)) {
+      while (node->parent != nullptr && !(node == node->parent->right && less_(node->parent->key, key))) {
+        node = node->parent;
+      }
+    }
+
     return node;
   }
 
+  NodeType* LowerBound(NodeType* node, const T& key) const {
+    NodeType* bound = nullptr;
+
+    while (node != nullptr) {
+      if (less_(node->key, key)) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
+      }
+    }
+
+    return bound;
+  }
+
+  static void Prefetch(const NodeType* node) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(node);
+#endif
+  }
+
+  static void SetLeft(NodeType* node, NodeType* child) {
+    node->left = child;
+
+    if (child != nullptr) {
+      child->parent = node;
+    }
+  }
+
+  static void SetRight(NodeType* node, NodeType* child) {
+    node->right = child;
+
+    if (child != nullptr) {
+      child->parent = node;
+    }
+  }
+
+  static void UpdateAggregate(NodeType* node) {
+    if constexpr (!std::is_same<Augmentation, NoAugmentation>::value) {
+      aggregate_type aggregate = Augmentation::Lift(node->key);
+
+      if (node->HasLeft()) {
+        aggregate = Augmentation::Combine(node->left->aggregate, aggregate);
+      }
+
+      if (node->HasRight()) {
+        aggregate = Augmentation::Combine(aggregate, node->right->aggregate);
+      }
+
+      node->aggregate = aggregate;
+    }
+  }
+
+  static void UpdatePath(NodeType* node) {
+    if constexpr (!std::is_same<Augmentation, NoAugmentation>::value) {
+      for (; node != nullptr; node = node->parent) {
+        UpdateAggregate(node);
+      }
+    }
+  }
+
+  aggregate_type Aggregate(const NodeType* node, const T& lo, const T& hi, bool check_lo, bool check_hi) const {
+    if (node == nullptr) {
+      return Augmentation::Identity();
+    }
+
+    if (!check_lo && !check_hi) {
+      return node->aggregate;
+    }
+
+    if (check_lo && less_(node->key, lo)) {
+      return Aggregate(node->right, lo, hi, check_lo, check_hi);
+    }
+
+    if (check_hi && less_(hi, node->key)) {
+      return Aggregate(node->left, lo, hi, check_lo, check_hi);
+    }
+
+    aggregate_type left = Aggregate(node->left, lo, hi, check_lo, false);
+    aggregate_type right = Aggregate(node->right, lo, hi, false, check_hi);
+
+    return Augmentation::Combine(Augmentation::Combine(left, Augmentation::Lift(node->key)), right);
+  }
+
   NodeType* FindFirst(NodeType* node, const T& key) const {
     if (node == nullptr) {
       return nullptr;
@@ -469,50 +1482,73 @@ class BinarySearchTree : public ITemplateTree<T, U> {
     return current;
   }
 
-  template<Traversable Traversal>
-  void Traverse(NodeType* node, const std::function<void(NodeType*)>& callback) {
-    if (node == nullptr) {
-      return;
-    }
-
-    if constexpr (std::is_same<Traversal, PreOrder>::value) {
+  template<typename Function, typename Node>
+  static bool Visit(Function& callback, Node* node) {
+    if constexpr (std::is_same<std::invoke_result_t<Function&, Node*>, bool>::value) {
+      return callback(node);
+    } else {
       callback(node);
+      return true;
     }
+  }
 
-    Traverse<Traversal>(node->left, callback);
-
-    if constexpr (std::is_same<Traversal, InOrder>::value) {
-      callback(node);
-    }
+  template<Traversable Traversal, typename Node, typename Function>
+  static bool Traverse(Node* node, Function&& callback) {
+    Node* stop = (node == nullptr) ? nullptr : node->parent;
+    bool from_left = false;
+
+    while (node != stop) {
+      if (!from_left) {
+        if constexpr (std::is_same<Traversal, PreOrder>::value) {
+          if (!Visit(callback, node)) {
+            return false;
+          }
+        }
 
-    Traverse<Traversal>(node->right, callback);
+        if (node->left != nullptr) {
+          node = node->left;
+          continue;
+        }
+      }
 
-    if constexpr (std::is_same<Traversal, PostOrder>::value) {
-      callback(node);
-    }
-  }
+      if constexpr (std::is_same<Traversal, InOrder>::value) {
+        if (!Visit(callback, node)) {
+          return false;
+        }
+      }
 
-  template<Traversable Traversal>
-  void Traverse(const NodeType* node, const std::function<void(const NodeType*)>& callback) const {
-    if (node == nullptr) {
-      return;
-    }
+      if (node->right != nullptr) {
+        node = node->right;
+        from_left = false;
+        continue;
+      }
 
-    if constexpr (std::is_same<Traversal, PreOrder>::value) {
-      callback(node);
-    }
+      Node* parent = node->parent;
+      bool is_left = parent != nullptr && node == parent->left;
 
-    Traverse<Traversal>(node->left, callback);
+      if constexpr (std::is_same<Traversal, PostOrder>::value) {
+        if (!Visit(callback, node)) {
+          return false;
+        }
+      }
 
-    if constexpr (std::is_same<Traversal, InOrder>::value) {
-      callback(node);
-    }
+      while (parent != stop && !is_left) {
+        node = parent;
+        parent = node->parent;
+        is_left = parent != nullptr && node == parent->left;
 
-    Traverse<Traversal>(node->right, callback);
+        if constexpr (std::is_same<Traversal, PostOrder>::value) {
+          if (!Visit(callback, node)) {
+            return false;
+          }
+        }
+      }
 
-    if constexpr (std::is_same<Traversal, PostOrder>::value) {
-      callback(node);
+      node = parent;
+      from_left = true;
     }
+
+    return true;
   }
 };
 
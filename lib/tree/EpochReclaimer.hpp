@@ -0,0 +1,116 @@
+#ifndef LIB_TREE_EPOCHRECLAIMER_HPP_
+#define LIB_TREE_EPOCHRECLAIMER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace bialger {
+
+/* Epoch-based reclamation shared by all lock-free readers of the process.
+ * A reader announces the global epoch in its own cache line for the duration
+ * of an EpochGuard and writes nothing else. A writer stamps unlinked nodes
+ * with the epoch after unlinking and frees them once every announced epoch is
+ * newer than the stamp. */
+
+struct alignas(64) EpochSlot {
+  std::atomic<uint64_t> epoch{std::numeric_limits<uint64_t>::max()};
+  std::atomic<bool> used{false};
+};
+
+class EpochReclaimer {
+ public:
+  static constexpr size_t kMaxThreads = 256;
+  static constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+  static void Enter() {
+    ThreadSlot& slot = GetThreadSlot();
+
+    if (slot.depth++ == 0) {
+      slots_[slot.index].epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  static void Exit() {
+    ThreadSlot& slot = GetThreadSlot();
+
+    if (--slot.depth == 0) {
+      slots_[slot.index].epoch.store(kIdle, std::memory_order_release);
+    }
+  }
+
+  static uint64_t GetRetireEpoch() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_relaxed);
+  }
+
+  static uint64_t GetSafeEpoch() {
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t safe = kIdle;
+
+    for (const EpochSlot& slot : slots_) {
+      uint64_t announced = slot.epoch.load(std::memory_order_acquire);
+
+      if (announced < safe) {
+        safe = announced;
+      }
+    }
+
+    return safe;
+  }
+
+ private:
+  struct ThreadSlot {
+    size_t index;
+    size_t depth;
+
+    ThreadSlot() : index(Acquire()), depth(0) {}
+
+    ~ThreadSlot() {
+      slots_[index].epoch.store(kIdle, std::memory_order_release);
+      slots_[index].used.store(false, std::memory_order_release);
+    }
+  };
+
+  inline static std::atomic<uint64_t> epoch_{0};
+  inline static EpochSlot slots_[kMaxThreads];
+
+  static ThreadSlot& GetThreadSlot() {
+    thread_local ThreadSlot slot;
+    return slot;
+  }
+
+  static size_t Acquire() {
+    for (size_t i = 0; i < kMaxThreads; ++i) {
+      bool expected = false;
+
+      if (!slots_[i].used.load(std::memory_order_relaxed)
+          && slots_[i].used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return i;
+      }
+    }
+
+    throw std::length_error("EpochReclaimer: too many concurrent reader threads");
+  }
+};
+
+class EpochGuard {
+ public:
+  EpochGuard() {
+    EpochReclaimer::Enter();
+  }
+
+  EpochGuard(const EpochGuard& other) = delete;
+  EpochGuard& operator=(const EpochGuard& other) = delete;
+
+  ~EpochGuard() {
+    EpochReclaimer::Exit();
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_EPOCHRECLAIMER_HPP_
@@ -8,10 +8,10 @@
 
 namespace bialger {
 
-template <typename T, typename U>
+template <typename T, typename U, typename A = EmptyAggregate>
 class ITemplateTree : public ITree {
  public:
-  using NodeType = TreeNode<T, U>;
+  using NodeType = TreeNode<T, U, A>;
   using key_type = T;
   using value_type = U;
   
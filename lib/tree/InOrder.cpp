@@ -31,9 +31,7 @@ bialger::ITreeNode* bialger::InOrder::GetPredecessor(bialger::ITreeNode* current
     return nullptr;
   }
 
-  if (current == GetFirst()) {
-    return tree_->GetEnd();
-  } else if (current == tree_->GetEnd()) {
+  if (current == tree_->GetEnd()) {
     return GetLast();
   }
 
@@ -49,7 +47,7 @@ bialger::ITreeNode* bialger::InOrder::GetPredecessor(bialger::ITreeNode* current
     parent = parent->GetParent();
   }
 
-  return parent;
+  return (parent == nullptr) ? tree_->GetEnd() : parent;
 }
 
 bialger::ITreeNode* bialger::InOrder::GetSuccessor(bialger::ITreeNode* current) const {
@@ -59,8 +57,6 @@ bialger::ITreeNode* bialger::InOrder::GetSuccessor(bialger::ITreeNode* current)
 
   if (current == tree_->GetEnd()) {
     return GetFirst();
-  } else if (current == GetLast()) {
-    return tree_->GetEnd();
   }
 
   if (current->HasRight()) {
@@ -75,7 +71,7 @@ bialger::ITreeNode* bialger::InOrder::GetSuccessor(bialger::ITreeNode* current)
     parent = parent->GetParent();
   }
 
-  return parent;
+  return (parent == nullptr) ? tree_->GetEnd() : parent;
 }
 
 bialger::ITreeNode* bialger::InOrder::GetMin(bialger::ITreeNode* current) {
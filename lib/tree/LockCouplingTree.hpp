@@ -0,0 +1,329 @@
+#ifndef LIB_TREE_LOCKCOUPLINGTREE_HPP_
+#define LIB_TREE_LOCKCOUPLINGTREE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include "TreeConcepts.hpp"
+#include "SharedSpinLock.hpp"
+
+namespace bialger {
+
+/* Concurrent unbalanced search tree with one reader-writer lock per node.
+ * Every operation locks top-down hand over hand with shared locks; a writer
+ * upgrades only the node it modifies, and does so while still holding the
+ * shared lock of that node's parent. Unlinking a node needs its parent
+ * exclusively, so no thread can hold an unprotected pointer to a node being
+ * unlinked, and removed nodes are freed immediately without a reclamation
+ * scheme. Disjoint subtrees are modified in parallel. */
+
+template<typename T>
+struct LockCouplingNode;
+
+template<typename T>
+struct LockCouplingLink {
+  SharedSpinLock lock;
+  LockCouplingNode<T>* children[2] = {nullptr, nullptr};
+};
+
+template<typename T>
+struct LockCouplingNode : LockCouplingLink<T> {
+  const T key;
+
+  explicit LockCouplingNode(const T& key) : key(key) {}
+};
+
+template<Allocable T, Comparator<T> Less, AllocatorType Allocator>
+class LockCouplingTree {
+ public:
+  using NodeType = LockCouplingNode<T>;
+  using LinkType = LockCouplingLink<T>;
+  using NodeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType>;
+
+  explicit LockCouplingTree(const Less& less = Less(), const Allocator& alloc = Allocator())
+      : head_(), node_allocator_(alloc), less_(less), size_(0) {}
+
+  LockCouplingTree(const LockCouplingTree& other) = delete;
+  LockCouplingTree& operator=(const LockCouplingTree& other) = delete;
+
+  ~LockCouplingTree() {
+    Clear();
+  }
+
+  void Clear() {
+    NodeType* node = head_.children[1];
+
+    while (node != nullptr) {
+      if (node->children[0] != nullptr) {
+        NodeType* left = node->children[0];
+        node->children[0] = left->children[1];
+        left->children[1] = node;
+        node = left;
+      } else {
+        NodeType* right = node->children[1];
+        DeleteNode(node);
+        node = right;
+      }
+    }
+
+    head_.children[1] = nullptr;
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+  bool Insert(const T& key) {
+    while (true) {
+      LinkType* grand = nullptr;
+      LinkType* parent = &head_;
+      size_t dir = 1;
+      parent->lock.lock_shared();
+
+      while (parent->children[dir] != nullptr) {
+        NodeType* current = parent->children[dir];
+        current->lock.lock_shared();
+
+        if (grand != nullptr) {
+          grand->lock.unlock_shared();
+        }
+
+        if (!less_(key, current->key) && !less_(current->key, key)) {
+          current->lock.unlock_shared();
+          parent->lock.unlock_shared();
+          return false;
+        }
+
+        grand = parent;
+        parent = current;
+        dir = less_(key, current->key) ? 0 : 1;
+      }
+
+      Upgrade(grand, parent);
+
+      if (parent->children[dir] == nullptr) {
+        parent->children[dir] = CreateNode(key);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        parent->lock.unlock();
+        return true;
+      }
+
+      parent->lock.unlock();
+    }
+  }
+
+  bool Delete(const T& key) {
+    while (true) {
+      LinkType* grand = nullptr;
+      LinkType* parent = &head_;
+      NodeType* current = nullptr;
+      size_t dir = 1;
+      parent->lock.lock_shared();
+
+      while (true) {
+        current = parent->children[dir];
+
+        if (current == nullptr) {
+          parent->lock.unlock_shared();
+
+          if (grand != nullptr) {
+            grand->lock.unlock_shared();
+          }
+
+          return false;
+        }
+
+        if (!less_(key, current->key) && !less_(current->key, key)) {
+          break;
+        }
+
+        current->lock.lock_shared();
+
+        if (grand != nullptr) {
+          grand->lock.unlock_shared();
+        }
+
+        grand = parent;
+        parent = current;
+        dir = less_(key, current->key) ? 0 : 1;
+      }
+
+      Upgrade(grand, parent);
+
+      if (parent->children[dir] != current) {
+        parent->lock.unlock();
+        continue;
+      }
+
+      current->lock.lock();
+
+      if (less_(key, current->key) || less_(current->key, key)) {
+        current->lock.unlock();
+        parent->lock.unlock();
+        continue;
+      }
+
+      Unlink(parent, dir, current);
+      current->lock.unlock();
+      parent->lock.unlock();
+      DeleteNode(current);
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  [[nodiscard]] bool Contains(const T& key) const {
+    bool found = false;
+
+    Descend(key, [&](const NodeType* node) {
+      if (!less_(key, node->key) && !less_(node->key, key)) {
+        found = true;
+        return false;
+      }
+
+      return true;
+    });
+
+    return found;
+  }
+
+  [[nodiscard]] std::optional<T> LowerBound(const T& key) const {
+    std::optional<T> bound;
+
+    Descend(key, [&](const NodeType* node) {
+      if (!less_(node->key, key)) {
+        bound.emplace(node->key);
+      }
+
+      return less_(node->key, key) || less_(key, node->key);
+    });
+
+    return bound;
+  }
+
+  [[nodiscard]] std::optional<T> UpperBound(const T& key) const {
+    std::optional<T> bound;
+
+    Descend(key, [&](const NodeType* node) {
+      if (less_(key, node->key)) {
+        bound.emplace(node->key);
+      }
+
+      return true;
+    });
+
+    return bound;
+  }
+
+  template<typename Function>
+  void TraverseInOrder(Function&& function) const {
+    TraverseInOrder(head_.children[1], function);
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] Less GetComparator() const {
+    return less_;
+  }
+
+  [[nodiscard]] Allocator GetAllocator() const {
+    return Allocator(node_allocator_);
+  }
+
+ protected:
+  using NodeAllocatorTraits = std::allocator_traits<NodeAllocatorType>;
+
+  mutable LinkType head_;
+  NodeAllocatorType node_allocator_;
+  Less less_;
+  std::atomic<size_t> size_;
+
+  NodeType* CreateNode(const T& key) {
+    NodeType* new_node = NodeAllocatorTraits::allocate(node_allocator_, 1);
+    NodeAllocatorTraits::construct(node_allocator_, new_node, key);
+
+    return new_node;
+  }
+
+  void DeleteNode(NodeType* node) {
+    NodeAllocatorTraits::destroy(node_allocator_, node);
+    NodeAllocatorTraits::deallocate(node_allocator_, node, 1);
+  }
+
+  static void Upgrade(LinkType* grand, LinkType* parent) {
+    parent->lock.unlock_shared();
+    parent->lock.lock();
+
+    if (grand != nullptr) {
+      grand->lock.unlock_shared();
+    }
+  }
+
+  static void Unlink(LinkType* parent, size_t dir, NodeType* node) {
+    if (node->children[0] == nullptr || node->children[1] == nullptr) {
+      parent->children[dir] = (node->children[0] != nullptr) ? node->children[0] : node->children[1];
+      return;
+    }
+
+    NodeType* successor_parent = node;
+    NodeType* successor = node->children[1];
+    successor->lock.lock();
+
+    while (successor->children[0] != nullptr) {
+      NodeType* next = successor->children[0];
+      next->lock.lock();
+
+      if (successor_parent != node) {
+        successor_parent->lock.unlock();
+      }
+
+      successor_parent = successor;
+      successor = next;
+    }
+
+    if (successor_parent != node) {
+      successor_parent->children[0] = successor->children[1];
+      successor->children[1] = node->children[1];
+      successor_parent->lock.unlock();
+    }
+
+    successor->children[0] = node->children[0];
+    parent->children[dir] = successor;
+    successor->lock.unlock();
+  }
+
+  template<typename Visitor>
+  void Descend(const T& key, Visitor&& visitor) const {
+    LinkType* parent = &head_;
+    parent->lock.lock_shared();
+
+    for (NodeType* current = parent->children[1]; current != nullptr;) {
+      current->lock.lock_shared();
+      parent->lock.unlock_shared();
+      parent = current;
+
+      if (!visitor(static_cast<const NodeType*>(current))) {
+        break;
+      }
+
+      current = current->children[less_(key, current->key) ? 0 : 1];
+    }
+
+    parent->lock.unlock_shared();
+  }
+
+  template<typename Function>
+  static void TraverseInOrder(const NodeType* node, Function& function) {
+    if (node == nullptr) {
+      return;
+    }
+
+    TraverseInOrder(node->children[0], function);
+    function(node->key);
+    TraverseInOrder(node->children[1], function);
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_LOCKCOUPLINGTREE_HPP_
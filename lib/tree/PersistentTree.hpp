@@ -0,0 +1,372 @@
+#ifndef LIB_TREE_PERSISTENTTREE_HPP_
+#define LIB_TREE_PERSISTENTTREE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "TreeConcepts.hpp"
+
+namespace bialger {
+
+/* Persistent AVL tree with copy-on-write nodes. Nodes are reference counted,
+ * so a version is just a root: copying it is O(1). Insert/Delete walk the
+ * search path owning one reference to each node; a node whose count is one
+ * belongs to this version alone and is updated in place, a shared node is
+ * copied with its children acquired. Only the shared part of the O(log n)
+ * path is ever duplicated. */
+
+template<typename T>
+struct PersistentNode {
+  const T key;
+  PersistentNode* left;
+  PersistentNode* right;
+  int32_t height;
+  std::atomic<size_t> references;
+
+  PersistentNode(PersistentNode* left, const T& key, PersistentNode* right)
+      : key(key), left(left), right(right), height(1 + std::max(Height(left), Height(right))), references(1) {}
+
+  static int32_t Height(const PersistentNode* node) {
+    return (node == nullptr) ? 0 : node->height;
+  }
+};
+
+template<Allocable T, Comparator<T> Less, AllocatorType Allocator>
+class PersistentTree {
+ public:
+  using NodeType = PersistentNode<T>;
+  using NodeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType>;
+
+  explicit PersistentTree(const Less& less = Less(), const Allocator& alloc = Allocator())
+      : root_(nullptr), node_allocator_(alloc), less_(less), size_(0) {}
+
+  PersistentTree(const PersistentTree& other)
+      : root_(Acquire(other.root_)), node_allocator_(other.node_allocator_), less_(other.less_), size_(other.size_) {}
+
+  PersistentTree(PersistentTree&& other) noexcept
+      : root_(nullptr), node_allocator_(other.node_allocator_), less_(other.less_), size_(0) {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+  }
+
+  PersistentTree& operator=(const PersistentTree& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    NodeType* root = Acquire(other.root_);
+    Release(root_);
+    root_ = root;
+    node_allocator_ = other.node_allocator_;
+    less_ = other.less_;
+    size_ = other.size_;
+    return *this;
+  }
+
+  PersistentTree& operator=(PersistentTree&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    std::swap(root_, other.root_);
+    std::swap(node_allocator_, other.node_allocator_);
+    std::swap(less_, other.less_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~PersistentTree() {
+    Release(root_);
+  }
+
+  void Clear() {
+    Release(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  bool Insert(const T& key) {
+    if (FindFirst(key) != nullptr) {
+      return false;
+    }
+
+    root_ = Insert(root_, key);
+    ++size_;
+    return true;
+  }
+
+  bool Delete(const T& key) {
+    if (FindFirst(key) == nullptr) {
+      return false;
+    }
+
+    root_ = Delete(root_, key);
+    --size_;
+    return true;
+  }
+
+  [[nodiscard]] const NodeType* FindFirst(const T& key) const {
+    const NodeType* node = root_;
+
+    while (node != nullptr && (less_(key, node->key) || less_(node->key, key))) {
+      node = less_(key, node->key) ? node->left : node->right;
+    }
+
+    return node;
+  }
+
+  [[nodiscard]] const NodeType* LowerBound(const T& key) const {
+    const NodeType* bound = nullptr;
+
+    for (const NodeType* node = root_; node != nullptr;) {
+      if (less_(node->key, key)) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
+      }
+    }
+
+    return bound;
+  }
+
+  [[nodiscard]] const NodeType* UpperBound(const T& key) const {
+    const NodeType* bound = nullptr;
+
+    for (const NodeType* node = root_; node != nullptr;) {
+      if (less_(key, node->key)) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+
+    return bound;
+  }
+
+  [[nodiscard]] const NodeType* Predecessor(const T& key) const {
+    const NodeType* bound = nullptr;
+
+    for (const NodeType* node = root_; node != nullptr;) {
+      if (less_(node->key, key)) {
+        bound = node;
+        node = node->right;
+      } else {
+        node = node->left;
+      }
+    }
+
+    return bound;
+  }
+
+  [[nodiscard]] const NodeType* GetFirst() const {
+    const NodeType* node = root_;
+
+    while (node != nullptr && node->left != nullptr) {
+      node = node->left;
+    }
+
+    return node;
+  }
+
+  [[nodiscard]] const NodeType* GetLast() const {
+    const NodeType* node = root_;
+
+    while (node != nullptr && node->right != nullptr) {
+      node = node->right;
+    }
+
+    return node;
+  }
+
+  [[nodiscard]] const NodeType* GetRoot() const {
+    return root_;
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return size_;
+  }
+
+  [[nodiscard]] Less GetComparator() const {
+    return less_;
+  }
+
+  [[nodiscard]] Allocator GetAllocator() const {
+    return Allocator(node_allocator_);
+  }
+
+ protected:
+  using NodeAllocatorTraits = std::allocator_traits<NodeAllocatorType>;
+
+  NodeType* root_;
+  NodeAllocatorType node_allocator_;
+  Less less_;
+  size_t size_;
+
+  static NodeType* Acquire(NodeType* node) {
+    if (node != nullptr) {
+      node->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return node;
+  }
+
+  void Release(NodeType* node) {
+    while (node != nullptr && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      NodeType* right = node->right;
+      Release(node->left);
+      NodeAllocatorTraits::destroy(node_allocator_, node);
+      NodeAllocatorTraits::deallocate(node_allocator_, node, 1);
+      node = right;
+    }
+  }
+
+  NodeType* Make(NodeType* left, const T& key, NodeType* right) {
+    NodeType* new_node = NodeAllocatorTraits::allocate(node_allocator_, 1);
+    NodeAllocatorTraits::construct(node_allocator_, new_node, left, key, right);
+
+    return new_node;
+  }
+
+  static bool Open(NodeType* node, NodeType*& left, NodeType*& right) {
+    bool unique = node->references.load(std::memory_order_acquire) == 1;
+    left = node->left;
+    right = node->right;
+
+    if (!unique) {
+      Acquire(left);
+      Acquire(right);
+    }
+
+    return unique;
+  }
+
+  NodeType* Rebuild(NodeType* node, bool unique, NodeType* left, NodeType* right) {
+    if (unique) {
+      node->left = left;
+      node->right = right;
+      node->height = 1 + std::max(NodeType::Height(left), NodeType::Height(right));
+      return node;
+    }
+
+    NodeType* result = Make(left, node->key, right);
+    Release(node);
+    return result;
+  }
+
+  void Dispose(NodeType* node, bool unique) {
+    if (unique) {
+      NodeAllocatorTraits::destroy(node_allocator_, node);
+      NodeAllocatorTraits::deallocate(node_allocator_, node, 1);
+    } else {
+      Release(node);
+    }
+  }
+
+  NodeType* Balance(NodeType* node, bool unique, NodeType* left, NodeType* right) {
+    int32_t left_height = NodeType::Height(left);
+    int32_t right_height = NodeType::Height(right);
+
+    if (left_height > right_height + 1) {
+      NodeType* outer;
+      NodeType* inner;
+      bool left_unique = Open(left, outer, inner);
+
+      if (NodeType::Height(outer) >= NodeType::Height(inner)) {
+        return Rebuild(left, left_unique, outer, Rebuild(node, unique, inner, right));
+      }
+
+      NodeType* inner_left;
+      NodeType* inner_right;
+      bool inner_unique = Open(inner, inner_left, inner_right);
+
+      return Rebuild(inner, inner_unique,
+                     Rebuild(left, left_unique, outer, inner_left),
+                     Rebuild(node, unique, inner_right, right));
+    }
+
+    if (right_height > left_height + 1) {
+      NodeType* inner;
+      NodeType* outer;
+      bool right_unique = Open(right, inner, outer);
+
+      if (NodeType::Height(outer) >= NodeType::Height(inner)) {
+        return Rebuild(right, right_unique, Rebuild(node, unique, left, inner), outer);
+      }
+
+      NodeType* inner_left;
+      NodeType* inner_right;
+      bool inner_unique = Open(inner, inner_left, inner_right);
+
+      return Rebuild(inner, inner_unique,
+                     Rebuild(node, unique, left, inner_left),
+                     Rebuild(right, right_unique, inner_right, outer));
+    }
+
+    return Rebuild(node, unique, left, right);
+  }
+
+  NodeType* Insert(NodeType* node, const T& key) {
+    if (node == nullptr) {
+      return Make(nullptr, key, nullptr);
+    }
+
+    NodeType* left;
+    NodeType* right;
+    bool unique = Open(node, left, right);
+
+    if (less_(key, node->key)) {
+      left = Insert(left, key);
+    } else {
+      right = Insert(right, key);
+    }
+
+    return Balance(node, unique, left, right);
+  }
+
+  NodeType* Delete(NodeType* node, const T& key) {
+    NodeType* left;
+    NodeType* right;
+    bool unique = Open(node, left, right);
+
+    if (less_(key, node->key)) {
+      return Balance(node, unique, Delete(left, key), right);
+    }
+
+    if (less_(node->key, key)) {
+      return Balance(node, unique, left, Delete(right, key));
+    }
+
+    Dispose(node, unique);
+
+    if (left == nullptr || right == nullptr) {
+      return (left != nullptr) ? left : right;
+    }
+
+    NodeType* min = nullptr;
+    bool min_unique = false;
+    right = DeleteMin(right, min, min_unique);
+    return Balance(min, min_unique, left, right);
+  }
+
+  NodeType* DeleteMin(NodeType* node, NodeType*& min, bool& min_unique) {
+    NodeType* left;
+    NodeType* right;
+    bool unique = Open(node, left, right);
+
+    if (left == nullptr) {
+      min = node;
+      min_unique = unique;
+      return right;
+    }
+
+    return Balance(node, unique, DeleteMin(left, min, min_unique), right);
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_PERSISTENTTREE_HPP_
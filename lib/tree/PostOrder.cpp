@@ -45,9 +45,7 @@ bialger::ITreeNode* bialger::PostOrder::GetPredecessor(bialger::ITreeNode* curre
     return nullptr;
   }
 
-  if (current == GetFirst()) {
-    return tree_->GetEnd();
-  } else if (current == tree_->GetEnd()) {
+  if (current == tree_->GetEnd()) {
     return GetLast();
   }
 
@@ -77,8 +77,6 @@ bialger::ITreeNode* bialger::PreOrder::GetSuccessor(bialger::ITreeNode* current)
 
   if (current == tree_->GetEnd()) {
     return GetFirst();
-  } else if (current == GetLast()) {
-    return tree_->GetEnd();
   }
 
   if (current->HasLeft()) {
@@ -0,0 +1,324 @@
+#ifndef LIB_TREE_READMOSTLYTREE_HPP_
+#define LIB_TREE_READMOSTLYTREE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "TreeConcepts.hpp"
+#include "EpochReclaimer.hpp"
+
+namespace bialger {
+
+/* Unbalanced search tree with lock-free readers. Readers only load child
+ * pointers inside an EpochGuard. Writers are serialized by a mutex and never
+ * change a node a reader may be standing on in a way that hides a key: new
+ * leaves and one-child unlinks are single release stores, and a two-child
+ * unlink publishes a copied path with the successor's key in one store. */
+
+template<typename T>
+struct ReadMostlyNode {
+  const T key;
+  std::atomic<ReadMostlyNode*> children[2];
+  ReadMostlyNode* retired_next;
+  uint64_t retired_epoch;
+
+  explicit ReadMostlyNode(const T& key)
+      : key(key), children{nullptr, nullptr}, retired_next(nullptr), retired_epoch(0) {}
+};
+
+template<Allocable T, Comparator<T> Less, AllocatorType Allocator>
+class ReadMostlyTree {
+ public:
+  using NodeType = ReadMostlyNode<T>;
+  using NodeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType>;
+
+  explicit ReadMostlyTree(const Less& less = Less(), const Allocator& alloc = Allocator())
+      : root_(nullptr),
+        retired_head_(nullptr),
+        retired_tail_(nullptr),
+        retired_size_(0),
+        node_allocator_(alloc),
+        less_(less),
+        size_(0) {}
+
+  ReadMostlyTree(const ReadMostlyTree& other) = delete;
+  ReadMostlyTree& operator=(const ReadMostlyTree& other) = delete;
+
+  ~ReadMostlyTree() {
+    NodeType* chain = Collect(root_.load(std::memory_order_relaxed));
+
+    while (chain != nullptr) {
+      NodeType* next = chain->retired_next;
+      DeleteNode(chain);
+      chain = next;
+    }
+
+    FreeRetired(EpochReclaimer::kIdle);
+  }
+
+  void Clear() {
+    std::lock_guard lock(writer_mutex_);
+    NodeType* root = root_.exchange(nullptr, std::memory_order_acq_rel);
+    size_.store(0, std::memory_order_relaxed);
+    Retire(Collect(root));
+  }
+
+  bool Insert(const T& key) {
+    std::lock_guard lock(writer_mutex_);
+    std::atomic<NodeType*>* link = &root_;
+
+    for (NodeType* current = link->load(std::memory_order_relaxed); current != nullptr;
+         current = link->load(std::memory_order_relaxed)) {
+      if (!less_(key, current->key) && !less_(current->key, key)) {
+        return false;
+      }
+
+      link = &current->children[less_(key, current->key) ? 0 : 1];
+    }
+
+    link->store(CreateNode(key), std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool Delete(const T& key) {
+    std::lock_guard lock(writer_mutex_);
+    std::atomic<NodeType*>* link = &root_;
+    NodeType* node = link->load(std::memory_order_relaxed);
+
+    while (node != nullptr && (less_(key, node->key) || less_(node->key, key))) {
+      link = &node->children[less_(key, node->key) ? 0 : 1];
+      node = link->load(std::memory_order_relaxed);
+    }
+
+    if (node == nullptr) {
+      return false;
+    }
+
+    NodeType* left = node->children[0].load(std::memory_order_relaxed);
+    NodeType* right = node->children[1].load(std::memory_order_relaxed);
+    node->retired_next = nullptr;
+
+    if (left == nullptr || right == nullptr) {
+      link->store((left != nullptr) ? left : right, std::memory_order_release);
+    } else {
+      link->store(CopyWithSuccessor(node), std::memory_order_release);
+    }
+
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    Retire(node);
+    return true;
+  }
+
+  [[nodiscard]] bool Contains(const T& key) const {
+    bool found = false;
+
+    Descend(key, [&](const NodeType* node) {
+      found = !less_(key, node->key) && !less_(node->key, key);
+      return !found;
+    });
+
+    return found;
+  }
+
+  [[nodiscard]] std::optional<T> LowerBound(const T& key) const {
+    std::optional<T> bound;
+
+    Descend(key, [&](const NodeType* node) {
+      if (!less_(node->key, key)) {
+        bound.emplace(node->key);
+      }
+
+      return less_(node->key, key) || less_(key, node->key);
+    });
+
+    return bound;
+  }
+
+  [[nodiscard]] std::optional<T> UpperBound(const T& key) const {
+    std::optional<T> bound;
+
+    Descend(key, [&](const NodeType* node) {
+      if (less_(key, node->key)) {
+        bound.emplace(node->key);
+      }
+
+      return true;
+    });
+
+    return bound;
+  }
+
+  template<typename Function>
+  void TraverseInOrder(Function&& function) const {
+    EpochGuard guard;
+    TraverseInOrder(root_.load(std::memory_order_acquire), function);
+  }
+
+  void Reclaim() {
+    std::lock_guard lock(writer_mutex_);
+    FreeRetired(EpochReclaimer::GetSafeEpoch());
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] Less GetComparator() const {
+    return less_;
+  }
+
+  [[nodiscard]] Allocator GetAllocator() const {
+    return Allocator(node_allocator_);
+  }
+
+ protected:
+  using NodeAllocatorTraits = std::allocator_traits<NodeAllocatorType>;
+
+  static constexpr size_t kReclaimThreshold = 64;
+
+  std::atomic<NodeType*> root_;
+  NodeType* retired_head_;
+  NodeType* retired_tail_;
+  size_t retired_size_;
+  NodeAllocatorType node_allocator_;
+  Less less_;
+  std::atomic<size_t> size_;
+  std::mutex writer_mutex_;
+
+  NodeType* CreateNode(const T& key) {
+    NodeType* new_node = NodeAllocatorTraits::allocate(node_allocator_, 1);
+    NodeAllocatorTraits::construct(node_allocator_, new_node, key);
+
+    return new_node;
+  }
+
+  void DeleteNode(NodeType* node) {
+    NodeAllocatorTraits::destroy(node_allocator_, node);
+    NodeAllocatorTraits::deallocate(node_allocator_, node, 1);
+  }
+
+  NodeType* CopyWithSuccessor(NodeType* node) {
+    NodeType* successor = node->children[1].load(std::memory_order_relaxed);
+
+    while (successor->children[0].load(std::memory_order_relaxed) != nullptr) {
+      successor = successor->children[0].load(std::memory_order_relaxed);
+    }
+
+    NodeType* copy = CreateNode(successor->key);
+    copy->children[0].store(node->children[0].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    std::atomic<NodeType*>* link = &copy->children[1];
+    NodeType** retired = &node->retired_next;
+
+    for (NodeType* current = node->children[1].load(std::memory_order_relaxed); current != successor;
+         current = current->children[0].load(std::memory_order_relaxed)) {
+      NodeType* spine_copy = CreateNode(current->key);
+      spine_copy->children[1].store(current->children[1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      link->store(spine_copy, std::memory_order_relaxed);
+      link = &spine_copy->children[0];
+      *retired = current;
+      retired = &current->retired_next;
+    }
+
+    link->store(successor->children[1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    *retired = successor;
+    successor->retired_next = nullptr;
+
+    return copy;
+  }
+
+  static NodeType* Collect(NodeType* root) {
+    NodeType* stack = root;
+    NodeType* chain = nullptr;
+
+    if (stack != nullptr) {
+      stack->retired_next = nullptr;
+    }
+
+    while (stack != nullptr) {
+      NodeType* node = stack;
+      stack = node->retired_next;
+
+      for (std::atomic<NodeType*>& child : node->children) {
+        NodeType* next = child.load(std::memory_order_relaxed);
+
+        if (next != nullptr) {
+          next->retired_next = stack;
+          stack = next;
+        }
+      }
+
+      node->retired_next = chain;
+      chain = node;
+    }
+
+    return chain;
+  }
+
+  void Retire(NodeType* chain) {
+    if (chain == nullptr) {
+      return;
+    }
+
+    uint64_t epoch = EpochReclaimer::GetRetireEpoch();
+
+    for (NodeType* node = chain; node != nullptr; node = node->retired_next) {
+      node->retired_epoch = epoch;
+      ++retired_size_;
+
+      if (retired_tail_ == nullptr) {
+        retired_head_ = node;
+      } else {
+        retired_tail_->retired_next = node;
+      }
+
+      retired_tail_ = node;
+    }
+
+    if (retired_size_ >= kReclaimThreshold) {
+      FreeRetired(EpochReclaimer::GetSafeEpoch());
+    }
+  }
+
+  void FreeRetired(uint64_t safe_epoch) {
+    while (retired_head_ != nullptr && retired_head_->retired_epoch < safe_epoch) {
+      NodeType* next = retired_head_->retired_next;
+      DeleteNode(retired_head_);
+      retired_head_ = next;
+      --retired_size_;
+    }
+
+    if (retired_head_ == nullptr) {
+      retired_tail_ = nullptr;
+    }
+  }
+
+  template<typename Visitor>
+  void Descend(const T& key, Visitor&& visitor) const {
+    EpochGuard guard;
+
+    for (const NodeType* current = root_.load(std::memory_order_acquire); current != nullptr;
+         current = current->children[less_(key, current->key) ? 0 : 1].load(std::memory_order_acquire)) {
+      if (!visitor(current)) {
+        break;
+      }
+    }
+  }
+
+  template<typename Function>
+  static void TraverseInOrder(const NodeType* node, Function& function) {
+    if (node == nullptr) {
+      return;
+    }
+
+    TraverseInOrder(node->children[0].load(std::memory_order_acquire), function);
+    function(node->key);
+    TraverseInOrder(node->children[1].load(std::memory_order_acquire), function);
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_READMOSTLYTREE_HPP_
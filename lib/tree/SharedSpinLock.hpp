@@ -0,0 +1,88 @@
+#ifndef LIB_TREE_SHAREDSPINLOCK_HPP_
+#define LIB_TREE_SHAREDSPINLOCK_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace bialger {
+
+/* Word-sized reader-writer lock for per-node locking. A waiting writer sets
+ * kPending, which keeps new readers out until the writer gets in. */
+
+class SharedSpinLock {
+ public:
+  SharedSpinLock() : state_(0) {}
+
+  SharedSpinLock(const SharedSpinLock& other) = delete;
+  SharedSpinLock& operator=(const SharedSpinLock& other) = delete;
+
+  void lock() {
+    for (size_t spins = 0;; ++spins) {
+      uint32_t state = state_.load(std::memory_order_relaxed);
+
+      if ((state & ~kPending) == 0) {
+        if (state_.compare_exchange_weak(state, kWriter, std::memory_order_acquire, std::memory_order_relaxed)) {
+          return;
+        }
+      } else if ((state & kPending) == 0) {
+        state_.fetch_or(kPending, std::memory_order_relaxed);
+      }
+
+      Backoff(spins);
+    }
+  }
+
+  bool try_lock() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    return (state & ~kPending) == 0
+        && state_.compare_exchange_strong(state, kWriter, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock() {
+    state_.store(0, std::memory_order_release);
+  }
+
+  void lock_shared() {
+    for (size_t spins = 0;; ++spins) {
+      uint32_t state = state_.load(std::memory_order_relaxed);
+
+      if ((state & (kWriter | kPending)) == 0
+          && state_.compare_exchange_weak(state, state + kReader,
+                                          std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+      }
+
+      Backoff(spins);
+    }
+  }
+
+  bool try_lock_shared() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    return (state & (kWriter | kPending)) == 0
+        && state_.compare_exchange_strong(state, state + kReader,
+                                          std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock_shared() {
+    state_.fetch_sub(kReader, std::memory_order_release);
+  }
+
+ private:
+  static constexpr uint32_t kWriter = 1;
+  static constexpr uint32_t kPending = 2;
+  static constexpr uint32_t kReader = 4;
+  static constexpr size_t kSpinsBeforeYield = 64;
+
+  std::atomic<uint32_t> state_;
+
+  static void Backoff(size_t spins) {
+    if (spins >= kSpinsBeforeYield) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_SHAREDSPINLOCK_HPP_
@@ -0,0 +1,84 @@
+#ifndef LIB_TREE_TREEAUGMENTATION_HPP_
+#define LIB_TREE_TREEAUGMENTATION_HPP_
+
+#include <limits>
+#include <algorithm>
+
+namespace bialger {
+
+/* Augmentation is a monoid over the keys of the tree: every node caches
+ * Combine(left->aggregate, Lift(key), right->aggregate) of its subtree. */
+
+struct EmptyAggregate {};
+
+struct NoAugmentation {
+  using value_type = EmptyAggregate;
+
+  template<typename T>
+  static value_type Lift(const T&) {
+    return {};
+  }
+
+  static value_type Identity() {
+    return {};
+  }
+
+  static value_type Combine(const value_type&, const value_type&) {
+    return {};
+  }
+};
+
+template<typename T>
+struct SumAugmentation {
+  using value_type = T;
+
+  static value_type Lift(const T& key) {
+    return key;
+  }
+
+  static value_type Identity() {
+    return T{};
+  }
+
+  static value_type Combine(const value_type& lhs, const value_type& rhs) {
+    return lhs + rhs;
+  }
+};
+
+template<typename T>
+struct MinAugmentation {
+  using value_type = T;
+
+  static value_type Lift(const T& key) {
+    return key;
+  }
+
+  static value_type Identity() {
+    return std::numeric_limits<T>::max();
+  }
+
+  static value_type Combine(const value_type& lhs, const value_type& rhs) {
+    return std::min(lhs, rhs);
+  }
+};
+
+template<typename T>
+struct MaxAugmentation {
+  using value_type = T;
+
+  static value_type Lift(const T& key) {
+    return key;
+  }
+
+  static value_type Identity() {
+    return std::numeric_limits<T>::lowest();
+  }
+
+  static value_type Combine(const value_type& lhs, const value_type& rhs) {
+    return std::max(lhs, rhs);
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_TREEAUGMENTATION_HPP_
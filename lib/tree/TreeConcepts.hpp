@@ -37,6 +37,13 @@ concept AllocatorType = requires(Allocator& alloc) {
   { alloc.deallocate(alloc.allocate(1), 1) } -> std::same_as<void>;
 };
 
+template<typename Augmentation, typename T>
+concept AugmentationType = requires(const T& key, const typename Augmentation::value_type& aggregate) {
+  { Augmentation::Lift(key) } -> std::convertible_to<typename Augmentation::value_type>;
+  { Augmentation::Identity() } -> std::convertible_to<typename Augmentation::value_type>;
+  { Augmentation::Combine(aggregate, aggregate) } -> std::convertible_to<typename Augmentation::value_type>;
+};
+
 } // bialger
 
 #endif //LIB_TREE_TREE_CONCEPTS_HPP_
@@ -4,23 +4,31 @@
 #include <utility>
 
 #include "ITreeNode.hpp"
+#include "TreeAugmentation.hpp"
 
 namespace bialger {
 
-template<typename T, typename U>
+struct EmptyValue {};
+
+template<typename T, typename U, typename A = EmptyAggregate>
 class TreeNode : public ITreeNode {
  public:
   using key_type = T;
   using value_type = U;
+  using aggregate_type = A;
 
   T key;
-  U value;
-  TreeNode<T, U>* parent;
-  TreeNode<T, U>* left;
-  TreeNode<T, U>* right;
+  [[no_unique_address]] U value;
+  [[no_unique_address]] A aggregate;
+  TreeNode<T, U, A>* parent;
+  TreeNode<T, U, A>* left;
+  TreeNode<T, U, A>* right;
 
   TreeNode() = delete;
-  TreeNode(const T& key, const U& value) : key(key), value(value), parent(nullptr), left(nullptr), right(nullptr) {};
+  TreeNode(const T& key, const U& value)
+      : key(key), value(value), aggregate(), parent(nullptr), left(nullptr), right(nullptr) {};
+  TreeNode(const T& key, U&& value)
+      : key(key), value(std::move(value)), aggregate(), parent(nullptr), left(nullptr), right(nullptr) {};
 
   TreeNode(const TreeNode& other) = delete;
   TreeNode& operator=(const TreeNode& other) = delete;
@@ -29,6 +37,7 @@ class TreeNode : public ITreeNode {
   TreeNode(TreeNode&& other) noexcept {
     std::swap(key, other.key);
     std::swap(value, other.value);
+    std::swap(aggregate, other.aggregate);
     std::swap(parent, other.parent);
     std::swap(left, other.left);
     std::swap(right, other.right);
@@ -41,6 +50,7 @@ class TreeNode : public ITreeNode {
 
     std::swap(key, other.key);
     std::swap(value, other.value);
+    std::swap(aggregate, other.aggregate);
     std::swap(parent, other.parent);
     std::swap(left, other.left);
     std::swap(right, other.right);
@@ -0,0 +1,104 @@
+#ifndef LIB_TREE_TREENODEHANDLE_HPP_
+#define LIB_TREE_TREENODEHANDLE_HPP_
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace bialger {
+
+template<typename NodeType, typename NodeAllocator>
+class TreeNodeHandle {
+ private:
+  using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
+ public:
+  using key_type = typename NodeType::key_type;
+  using mapped_type = typename NodeType::value_type;
+  using allocator_type = NodeAllocator;
+
+  TreeNodeHandle() : node_(nullptr), node_allocator_() {}
+
+  TreeNodeHandle(NodeType* node, const NodeAllocator& alloc) : node_(node), node_allocator_(alloc) {}
+
+  TreeNodeHandle(const TreeNodeHandle& other) = delete;
+  TreeNodeHandle& operator=(const TreeNodeHandle& other) = delete;
+
+  TreeNodeHandle(TreeNodeHandle&& other) noexcept : node_(nullptr), node_allocator_(other.node_allocator_) {
+    std::swap(node_, other.node_);
+  }
+
+  TreeNodeHandle& operator=(TreeNodeHandle&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    Reset();
+    node_allocator_ = other.node_allocator_;
+    std::swap(node_, other.node_);
+    return *this;
+  }
+
+  ~TreeNodeHandle() {
+    Reset();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return node_ == nullptr;
+  }
+
+  explicit operator bool() const {
+    return node_ != nullptr;
+  }
+
+  key_type& key() const {
+    if (node_ == nullptr) {
+      throw std::out_of_range("Bad access attempt: empty node handle");
+    }
+
+    return node_->key;
+  }
+
+  mapped_type& mapped() const {
+    if (node_ == nullptr) {
+      throw std::out_of_range("Bad access attempt: empty node handle");
+    }
+
+    return node_->value;
+  }
+
+  allocator_type get_allocator() const {
+    return node_allocator_;
+  }
+
+  void swap(TreeNodeHandle& other) noexcept {
+    std::swap(node_, other.node_);
+    std::swap(node_allocator_, other.node_allocator_);
+  }
+
+  NodeType* Get() const {
+    return node_;
+  }
+
+  NodeType* Release() {
+    NodeType* node = node_;
+    node_ = nullptr;
+    return node;
+  }
+
+ private:
+  NodeType* node_;
+  NodeAllocator node_allocator_;
+
+  void Reset() {
+    if (node_ != nullptr) {
+      NodeAllocatorTraits::destroy(node_allocator_, node_);
+      NodeAllocatorTraits::deallocate(node_allocator_, node_, 1);
+      node_ = nullptr;
+    }
+  }
+};
+
+} // bialger
+
+#endif //LIB_TREE_TREENODEHANDLE_HPP_
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/BstMap.hpp"
+#include "custom_classes.hpp"
+
+using namespace bialger;
+
+TEST(BstMapTestSuite, EmptyTest) {
+  BstMap<int32_t, std::string> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.size(), 0);
+  ASSERT_TRUE(map.begin() == map.end());
+  ASSERT_THROW(map.at(0), std::out_of_range);
+  ASSERT_FALSE(map.contains(0));
+}
+
+TEST(BstMapTestSuite, SubscriptTest) {
+  std::vector<int32_t> values = GetRandomNumbers(1000);
+  BstMap<int32_t, int32_t> map;
+  std::map<int32_t, int32_t> std_map;
+
+  for (int32_t value : values) {
+    ++map[value % 100];
+    ++std_map[value % 100];
+  }
+
+  ASSERT_EQ(map.size(), std_map.size());
+
+  for (auto [key, value] : std_map) {
+    ASSERT_EQ(map.at(key), value);
+  }
+}
+
+TEST(BstMapTestSuite, TryEmplaceTest) {
+  BstMap<int32_t, std::string> map;
+  auto first = map.try_emplace(1, 3, 'a');
+  auto second = map.try_emplace(1, "b");
+
+  ASSERT_TRUE(first.second);
+  ASSERT_FALSE(second.second);
+  ASSERT_TRUE(first.first == second.first);
+  ASSERT_EQ(map.at(1), "aaa");
+  ASSERT_EQ(map.size(), 1);
+}
+
+TEST(BstMapTestSuite, InsertOrAssignTest) {
+  BstMap<std::string, int32_t> map = {{"a", 1}, {"b", 2}};
+  auto inserted = map.insert_or_assign("c", 3);
+  auto assigned = map.insert_or_assign("a", 10);
+
+  ASSERT_TRUE(inserted.second);
+  ASSERT_FALSE(assigned.second);
+  ASSERT_EQ(assigned.first->second, 10);
+  ASSERT_FALSE(map.insert({"b", 20}).second);
+  ASSERT_EQ(map["b"], 2);
+  ASSERT_EQ(map.size(), 3);
+}
+
+TEST(BstMapTestSuite, IteratorTest) {
+  BstMap<int32_t, int32_t> map = {{3, 30}, {1, 10}, {2, 20}};
+  std::vector<std::pair<int32_t, int32_t>> items;
+
+  for (auto [key, value] : map) {
+    value += 1;
+    items.emplace_back(key, value);
+  }
+
+  ASSERT_EQ(items, (std::vector<std::pair<int32_t, int32_t>>{{1, 11}, {2, 21}, {3, 31}}));
+  ASSERT_EQ(map.at(2), 21);
+
+  const BstMap<int32_t, int32_t>& const_map = map;
+  ASSERT_EQ(const_map.find(3)->second, 31);
+  ASSERT_EQ((*--const_map.end()).first, 3);
+  ASSERT_EQ(map.rbegin()->first, 3);
+  ASSERT_EQ(map.lower_bound(2)->first, 2);
+  ASSERT_EQ(map.upper_bound(2)->first, 3);
+}
+
+TEST(BstMapTestSuite, EraseTest) {
+  std::vector<int32_t> values = GetRandomNumbers(1000);
+  BstMap<int32_t, int32_t, std::less<>, CountingAllocator<std::pair<const int32_t, int32_t>>> map;
+  std::map<int32_t, int32_t> std_map;
+
+  for (int32_t value : values) {
+    map.insert_or_assign(value, value / 2);
+    std_map.insert_or_assign(value, value / 2);
+  }
+
+  for (size_t i = 0; i < values.size(); i += 2) {
+    ASSERT_EQ(map.erase(values[i]), std_map.erase(values[i]));
+  }
+
+  ASSERT_EQ(map.size(), std_map.size());
+  auto it = map.begin();
+
+  for (auto [key, value] : std_map) {
+    ASSERT_EQ(it->first, key);
+    ASSERT_EQ(it->second, value);
+    it = map.erase(it);
+  }
+
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.get_allocator().GetAllocationsCount(), map.get_allocator().GetDeallocationsCount());
+}
+
+TEST(BstMapTestSuite, NonStrictComparatorTest) {
+  BstMap<int32_t, int32_t, std::less_equal<>> map;
+  ASSERT_THROW(map[1], std::invalid_argument);
+  ASSERT_THROW(map.try_emplace(1, 1), std::invalid_argument);
+  ASSERT_TRUE(map.empty());
+}
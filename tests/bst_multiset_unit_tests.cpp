@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "lib/bst/BstMultiset.hpp"
+#include "custom_classes.hpp"
+
+using namespace bialger;
+
+TEST(BstMultisetTestSuite, EmptyTest) {
+  BstMultiset<int32_t> multiset;
+  ASSERT_TRUE(multiset.empty());
+  ASSERT_EQ(multiset.size(), 0);
+  ASSERT_EQ(multiset.count(0), 0);
+  ASSERT_TRUE(multiset.begin() == multiset.end());
+}
+
+TEST(BstMultisetTestSuite, CountCompressionTest) {
+  BstMultiset<int32_t, std::less<>, CountingAllocator<int32_t>> multiset;
+
+  for (int32_t i = 0; i < 10000; ++i) {
+    multiset.insert(i % 10);
+  }
+
+  multiset.insert(3, 1000);
+
+  ASSERT_EQ(multiset.size(), 11000);
+  ASSERT_EQ(multiset.distinct_size(), 10);
+  ASSERT_EQ(multiset.count(3), 2000);
+  ASSERT_EQ(multiset.count(5), 1000);
+  ASSERT_EQ(multiset.get_allocator().GetAllocationsCount(), 10);
+}
+
+TEST(BstMultisetTestSuite, ZeroRepetitionsTest) {
+  BstMultiset<int32_t> multiset = {1, 3};
+
+  ASSERT_TRUE(multiset.insert(2, 0) == multiset.end());
+  ASSERT_FALSE(multiset.contains(2));
+  ASSERT_EQ(multiset.count(2), 0);
+  ASSERT_EQ(multiset.distinct_size(), 2);
+  ASSERT_EQ(*multiset.insert(3, 0), 3);
+  ASSERT_EQ(multiset.count(3), 1);
+  ASSERT_EQ(std::vector<int32_t>(multiset.begin(), multiset.end()), std::vector<int32_t>({1, 3}));
+}
+
+TEST(BstMultisetTestSuite, IterationTest) {
+  std::vector<int32_t> values = GetRandomNumbers(1000);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    values.push_back(values[i % 100]);
+  }
+
+  BstMultiset<int32_t> multiset(values.begin(), values.end());
+  std::multiset<int32_t> std_multiset(values.begin(), values.end());
+
+  ASSERT_EQ(multiset.size(), std_multiset.size());
+  ASSERT_TRUE(std::equal(multiset.begin(), multiset.end(), std_multiset.begin(), std_multiset.end()));
+  ASSERT_TRUE(std::equal(multiset.rbegin(), multiset.rend(), std_multiset.rbegin(), std_multiset.rend()));
+  ASSERT_EQ(std::distance(multiset.begin(), multiset.end()), values.size());
+
+  auto it = multiset.end();
+  auto std_it = std_multiset.end();
+
+  while (it != multiset.begin()) {
+    ASSERT_EQ(*--it, *--std_it);
+  }
+}
+
+TEST(BstMultisetTestSuite, EraseTest) {
+  BstMultiset<int32_t> multiset = {1, 2, 2, 2, 3, 3, 4};
+
+  ASSERT_EQ(multiset.erase(2), 3);
+  ASSERT_EQ(multiset.erase(5), 0);
+  ASSERT_EQ(multiset.size(), 4);
+
+  auto it = multiset.find(3);
+  it = multiset.erase(it);
+  ASSERT_EQ(*it, 3);
+  it = multiset.erase(it);
+  ASSERT_EQ(*it, 4);
+  ASSERT_FALSE(multiset.contains(3));
+  ASSERT_EQ(multiset, (BstMultiset<int32_t>{1, 4}));
+}
+
+TEST(BstMultisetTestSuite, BoundsTest) {
+  BstMultiset<int32_t> multiset = {1, 3, 3, 3, 5};
+  auto range = multiset.equal_range(3);
+
+  ASSERT_EQ(std::distance(range.first, range.second), 3);
+  ASSERT_EQ(*multiset.lower_bound(2), 3);
+  ASSERT_EQ(*multiset.upper_bound(3), 5);
+  ASSERT_TRUE(multiset.upper_bound(5) == multiset.end());
+}
@@ -138,3 +138,55 @@ TEST_F(BstTraversalUnitTestSuite, PostOrderTraverseTreeBothWaysTest1) {
     iterator_traversal << *it << ' ';
   }
 }
+
+TEST_F(BstTraversalUnitTestSuite, PrintToStreamSeparatorTest) {
+  std::ostringstream post_order_traversal;
+  std::ostringstream expected_post_order;
+  bst.PrintToStream<PreOrder>(real_traversal, "\n");
+  bst.PrintToStream<PostOrder>(post_order_traversal, ", ");
+
+  for (auto it = bst.begin<PreOrder>(); it != bst.end<PreOrder>(); ++it) {
+    iterator_traversal << *it << '\n';
+  }
+
+  for (auto it = bst.begin<PostOrder>(); it != bst.end<PostOrder>(); ++it) {
+    expected_post_order << *it << ", ";
+  }
+
+  ASSERT_EQ(post_order_traversal.str(), expected_post_order.str());
+}
+
+TEST_F(BstTraversalUnitTestSuite, PrintToStreamFormattingTest) {
+  BST<double> doubles;
+  BST<std::string> words = {"b", "a", std::string(100000, 'c')};
+  std::ostringstream hex_traversal;
+  std::ostringstream words_traversal;
+  std::ostringstream expected_hex;
+  std::ostringstream expected_words;
+
+  for (int32_t value : values) {
+    doubles.insert(value / 7.0);
+  }
+
+  for (double key : doubles) {
+    iterator_traversal << key << ' ';
+  }
+
+  hex_traversal << std::hex;
+  expected_hex << std::hex;
+
+  for (int32_t key : bst) {
+    expected_hex << key << ' ';
+  }
+
+  for (const std::string& key : words) {
+    expected_words << key << ' ';
+  }
+
+  doubles.PrintToStream(real_traversal);
+  bst.PrintToStream(hex_traversal);
+  words.PrintToStream(words_traversal);
+
+  ASSERT_EQ(hex_traversal.str(), expected_hex.str());
+  ASSERT_EQ(words_traversal.str(), expected_words.str());
+}
@@ -1,9 +1,19 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
 #include <sstream>
 
 #include <vector>
 #include <set>
 #include <gtest/gtest.h>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "lib/bst/BstSerialization.hpp"
+#include "lib/bst/BstStreamReader.hpp"
 #include "BstUnitTestSuite.hpp"
 
 using namespace bialger;
@@ -159,6 +169,29 @@ TEST_F(BstUnitTestSuite, ConstructTest3) {
   ASSERT_EQ(sample_values, data_inorder);
 }
 
+
+TEST_F(BstUnitTestSuite, ConstructBalancedTest) {
+  BST<int32_t> bst2(values.begin(), values.end());
+  std::vector<int32_t> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  std::vector<int32_t> expected;
+
+  auto median_order = [&](auto&& self, size_t first, size_t count) -> void {
+    if (count == 0) {
+      return;
+    }
+
+    expected.push_back(sorted[first + count / 2]);
+    self(self, first, count / 2);
+    self(self, first + count / 2 + 1, count - count / 2 - 1);
+  };
+  median_order(median_order, 0, sorted.size());
+
+  ASSERT_EQ(bst2.size(), sorted.size());
+  ASSERT_TRUE(std::equal(bst2.begin<PreOrder>(), bst2.end<PreOrder>(), expected.begin(), expected.end()));
+}
+
 TEST_F(BstUnitTestSuite, EqualComparatorAllocatorTest1) {
   BST<int32_t, LessContainer<void>, CountingAllocator<int32_t>> bst2(custom_allocator);
 
@@ -539,6 +572,36 @@ TEST_F(BstUnitTestSuite, InsertTest8) {
   ASSERT_EQ(values_unique, data_inorder);
 }
 
+TEST_F(BstUnitTestSuite, InsertSortedBatchTest1) {
+  bst.insert(values_unique.begin(), values_unique.begin() + size / 2);
+  std::vector<int32_t> batch(values.begin(), values.end());
+  std::sort(batch.begin(), batch.end());
+  bst.insert_sorted_batch(batch.begin(), batch.end());
+
+  std::set<int32_t> expected(values_unique.begin(), values_unique.begin() + size / 2);
+  expected.insert(values.begin(), values.end());
+
+  ASSERT_EQ(bst.size(), expected.size());
+  ASSERT_TRUE(std::equal(bst.begin(), bst.end(), expected.begin(), expected.end()));
+}
+
+TEST_F(BstUnitTestSuite, InsertSortedBatchTest2) {
+  BST<int64_t, std::less<>, std::allocator<int64_t>, SumAugmentation<int64_t>> sum_bst = {50, 10, 90};
+  std::vector<int64_t> batch = {5, 10, 20, 30, 60, 95, 100};
+  sum_bst.insert_sorted_batch(batch.begin(), batch.end());
+
+  ASSERT_EQ(sum_bst.size(), 9);
+  ASSERT_EQ(sum_bst.aggregate(0, 1000), 460);
+  ASSERT_EQ(sum_bst.aggregate(10, 60), 170);
+
+  std::vector<int64_t> unsorted = {7, 3, 200, 1};
+  sum_bst.insert_sorted_batch(unsorted.begin(), unsorted.end());
+
+  ASSERT_EQ(sum_bst.size(), 13);
+  ASSERT_TRUE(std::is_sorted(sum_bst.begin(), sum_bst.end()));
+  ASSERT_EQ(sum_bst.aggregate(0, 1000), 671);
+}
+
 TEST_F(BstUnitTestSuite, ClearTest) {
   bst.insert(values);
 
@@ -612,6 +675,65 @@ TEST_F(BstUnitTestSuite, EraseTest4) {
   ASSERT_EQ(bst.size(), size - erase_count);
 }
 
+TEST_F(BstUnitTestSuite, EraseTest5) {
+  custom_bst.insert(values_unique);
+  std::shuffle(values_unique.begin(), values_unique.end(), rng);
+
+  for (size_t i = 0; i < size / 2; ++i) {
+    custom_bst.erase_without_successor(custom_bst.find(values_unique[i]));
+    ASSERT_FALSE(custom_bst.contains(values_unique[i]));
+  }
+
+  for (size_t i = size / 2; i < size; ++i) {
+    ASSERT_EQ(custom_bst.erase(values_unique[i]), 1);
+    ASSERT_EQ(custom_bst.erase(values_unique[i]), 0);
+  }
+
+  ASSERT_TRUE(custom_bst.empty());
+  ASSERT_EQ(custom_bst.get_allocator().GetAllocationsCount(), custom_bst.get_allocator().GetDeallocationsCount());
+}
+
+TEST_F(BstUnitTestSuite, EraseRangeTest1) {
+  for (size_t i = 0; i < 50; ++i) {
+    custom_bst.insert(values_unique);
+    std::set<int32_t> set(values_unique.begin(), values_unique.end());
+    int32_t lo = static_cast<int32_t>(dist(rng) % (distance * size));
+    int32_t hi = lo + static_cast<int32_t>(dist(rng) % (distance * size / 2));
+
+    auto last = custom_bst.lower_bound(hi);
+    auto result = custom_bst.erase(custom_bst.lower_bound(lo), last);
+    set.erase(set.lower_bound(lo), set.lower_bound(hi));
+
+    ASSERT_TRUE(result == last);
+    ASSERT_EQ(custom_bst.size(), set.size());
+    ASSERT_TRUE(std::equal(custom_bst.begin(), custom_bst.end(), set.begin(), set.end()));
+    custom_bst.clear();
+  }
+
+  ASSERT_EQ(custom_bst.get_allocator().GetAllocationsCount(), custom_bst.get_allocator().GetDeallocationsCount());
+}
+
+TEST_F(BstUnitTestSuite, EraseRangeTest2) {
+  BST<int64_t, std::less<>, std::allocator<int64_t>, SumAugmentation<int64_t>> sum_bst;
+  sum_bst.insert(values_unique.begin(), values_unique.end());
+  std::sort(values_unique.begin(), values_unique.end());
+  const int64_t threshold = values_unique[size / 3];
+  int64_t expected = 0;
+
+  for (int32_t value : values_unique) {
+    expected += (value >= threshold) ? value : 0;
+  }
+
+  auto result = sum_bst.erase(sum_bst.begin(), sum_bst.lower_bound(threshold));
+  ASSERT_TRUE(result == sum_bst.begin());
+  ASSERT_EQ(*sum_bst.begin(), threshold);
+  ASSERT_EQ(sum_bst.size(), size - size / 3);
+  ASSERT_EQ(sum_bst.aggregate(0, static_cast<int64_t>(distance * size)), expected);
+
+  sum_bst.erase(sum_bst.begin(), sum_bst.end());
+  ASSERT_TRUE(sum_bst.empty());
+}
+
 TEST_F(BstUnitTestSuite, EraseIfTest) {
   bst.insert(values_unique);
   size_t erase_count = 0;
@@ -628,6 +750,132 @@ TEST_F(BstUnitTestSuite, EraseIfTest) {
   ASSERT_EQ(bst.size(), size - erase_count);
 }
 
+TEST_F(BstUnitTestSuite, MergeTest1) {
+  BST<int32_t, LessContainer<void>, CountingAllocator<int32_t>> lhs(custom_comparator, custom_allocator);
+  BST<int32_t, LessContainer<void>, CountingAllocator<int32_t>> rhs(custom_comparator, custom_allocator);
+  std::set<int32_t> lhs_set(values_unique.begin(), values_unique.begin() + size / 2);
+  std::set<int32_t> rhs_set(values_unique.begin() + size / 4, values_unique.end());
+  lhs.insert(lhs_set);
+  rhs.insert(rhs_set);
+  size_t lhs_allocations = lhs.get_allocator().GetAllocationsCount();
+
+  lhs.merge(rhs);
+  lhs_set.merge(rhs_set);
+
+  ASSERT_EQ(lhs.get_allocator().GetAllocationsCount(), lhs_allocations);
+  ASSERT_EQ(rhs.get_allocator().GetDeallocationsCount(), 0);
+  ASSERT_EQ(lhs.size(), lhs_set.size());
+  ASSERT_EQ(rhs.size(), rhs_set.size());
+  ASSERT_TRUE(std::equal(lhs.begin(), lhs.end(), lhs_set.begin(), lhs_set.end()));
+  ASSERT_TRUE(std::equal(rhs.begin(), rhs.end(), rhs_set.begin(), rhs_set.end()));
+}
+
+TEST_F(BstUnitTestSuite, MergeTest2) {
+  BST<int32_t, LessContainer<void>, CountingAllocator<int32_t>> other;
+  custom_bst.insert(values_unique.begin(), values_unique.begin() + size / 2);
+  other.insert(values_unique.begin() + size / 4, values_unique.end());
+
+  custom_bst.merge(std::move(other));
+
+  ASSERT_EQ(custom_bst.size(), size);
+  ASSERT_EQ(other.size(), size / 4);
+  std::sort(values_unique.begin(), values_unique.end());
+  ASSERT_TRUE(std::equal(custom_bst.begin(), custom_bst.end(), values_unique.begin(), values_unique.end()));
+}
+
+TEST_F(BstUnitTestSuite, MergeSmallIntoLargeTest) {
+  BST<int32_t> other = {values_unique[0], values_unique[1], std::numeric_limits<int32_t>::max()};
+  bst.insert(values_unique.begin(), values_unique.end());
+  int32_t root = *bst.begin<PreOrder>();
+
+  bst.merge(other);
+
+  ASSERT_EQ(*bst.begin<PreOrder>(), root);
+  ASSERT_EQ(bst.size(), values_unique.size() + (bst.contains(std::numeric_limits<int32_t>::max()) ? 1 : 0));
+  ASSERT_EQ(other.size(), 2);
+  ASSERT_TRUE(other.contains(values_unique[0]) && other.contains(values_unique[1]));
+  ASSERT_TRUE(std::is_sorted(bst.begin(), bst.end()));
+}
+
+TEST_F(BstUnitTestSuite, SetOperationsTest) {
+  std::vector<int32_t> lhs_values(values_unique.begin(), values_unique.begin() + size * 2 / 3);
+  std::vector<int32_t> rhs_values(values_unique.begin() + size / 3, values_unique.end());
+  BST<int32_t> lhs(lhs_values.begin(), lhs_values.end());
+  BST<int32_t> rhs(rhs_values.begin(), rhs_values.end());
+  std::sort(lhs_values.begin(), lhs_values.end());
+  std::sort(rhs_values.begin(), rhs_values.end());
+  std::vector<int32_t> expected;
+
+  std::set_union(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                 std::back_inserter(expected));
+  BST<int32_t> result = set_union(lhs, rhs);
+  ASSERT_EQ(result.size(), expected.size());
+  ASSERT_TRUE(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+
+  expected.clear();
+  std::set_intersection(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                        std::back_inserter(expected));
+  result = set_intersection(lhs, rhs);
+  ASSERT_EQ(result.size(), expected.size());
+  ASSERT_TRUE(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+
+  expected.clear();
+  std::set_difference(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                      std::back_inserter(expected));
+  result = set_difference(lhs, rhs);
+  ASSERT_EQ(result.size(), expected.size());
+  ASSERT_TRUE(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+
+  for (int32_t value : expected) {
+    ASSERT_TRUE(result.contains(value));
+  }
+}
+
+TEST_F(BstUnitTestSuite, ExtractTest1) {
+  BST<int32_t, LessContainer<void>, CountingAllocator<int32_t>> lhs(custom_comparator, custom_allocator);
+  BST<int32_t, LessContainer<void>, CountingAllocator<int32_t>> rhs(custom_comparator, custom_allocator);
+  lhs.insert(values_unique);
+  size_t lhs_allocations = lhs.get_allocator().GetAllocationsCount();
+
+  for (size_t i = 0; i < size / 2; ++i) {
+    auto result = rhs.insert(lhs.extract(values_unique[i]));
+    ASSERT_TRUE(result.inserted);
+    ASSERT_TRUE(result.node.empty());
+    ASSERT_EQ(*result.position, values_unique[i]);
+  }
+
+  ASSERT_EQ(lhs.size(), size - size / 2);
+  ASSERT_EQ(rhs.size(), size / 2);
+  ASSERT_EQ(lhs.get_allocator().GetAllocationsCount(), lhs_allocations);
+  ASSERT_EQ(lhs.get_allocator().GetDeallocationsCount(), 0);
+  ASSERT_EQ(rhs.get_allocator().GetAllocationsCount(), 0);
+
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_TRUE((i < size / 2) ? rhs.contains(values_unique[i]) : lhs.contains(values_unique[i]));
+  }
+}
+
+TEST_F(BstUnitTestSuite, ExtractTest2) {
+  BST<int64_t, std::less<>, std::allocator<int64_t>, SumAugmentation<int64_t>> sum_bst = {1, 2, 3, 4, 5};
+
+  auto node = sum_bst.extract(sum_bst.find(3));
+  ASSERT_EQ(sum_bst.aggregate(1, 5), 12);
+  ASSERT_TRUE(sum_bst.extract(3).empty());
+
+  node.key() = 10;
+  auto result = sum_bst.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ(sum_bst.aggregate(1, 10), 22);
+
+  auto duplicate = sum_bst.extract(sum_bst.begin());
+  sum_bst.insert(1);
+  result = sum_bst.insert(std::move(duplicate));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_FALSE(result.node.empty());
+  ASSERT_EQ(result.node.key(), 1);
+  ASSERT_EQ(sum_bst.size(), 5);
+}
+
 TEST_F(BstUnitTestSuite, FindTest1) {
   bst.insert(values);
 
@@ -648,6 +896,79 @@ TEST_F(BstUnitTestSuite, FindTest2) {
   }
 }
 
+TEST_F(BstUnitTestSuite, FindBatchTest1) {
+  bst.insert(values_unique);
+  std::vector<int32_t> keys;
+
+  for (size_t i = 0; i < size; ++i) {
+    keys.push_back(values_unique[i]);
+    keys.push_back(values_unique[i] + 1000000);
+  }
+
+  std::vector<BST<int32_t>::iterator> result(keys.size());
+  bst.find_batch(keys, result);
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_TRUE(result[i] == bst.find(keys[i]));
+  }
+}
+
+TEST_F(BstUnitTestSuite, FindBatchTest2) {
+  std::vector<BST<int32_t>::iterator> result(3);
+  std::vector<int32_t> keys = {1, 2, 3};
+  bst.find_batch(keys, result);
+
+  for (auto& it : result) {
+    ASSERT_TRUE(it == bst.end());
+  }
+
+  bst.insert(2);
+  bst.find_batch(std::span<const int32_t>(), result);
+  ASSERT_TRUE(result[1] == bst.end());
+  ASSERT_THROW(bst.find_batch(keys, std::span(result).first(2)), std::invalid_argument);
+}
+
+TEST_F(BstUnitTestSuite, FindFromTest) {
+  bst.insert(values_unique);
+  auto finger = bst.end();
+
+  for (size_t i = 0; i < size; ++i) {
+    int32_t key = values_unique[(i * 7) % size];
+    finger = bst.find_from(finger, key);
+    ASSERT_EQ(*finger, key);
+    ASSERT_TRUE(bst.find_from(finger, key + 1000000) == bst.end());
+    ASSERT_TRUE(bst.find_from(bst.find<PreOrder>(key), key) == bst.find<PreOrder>(key));
+  }
+}
+
+TEST_F(BstUnitTestSuite, EmptyFingerTest) {
+  bst.insert(values_unique);
+  int32_t key = values_unique[size / 2];
+
+  ASSERT_EQ(*bst.find_from(BST<int32_t>::const_iterator(), key), key);
+  ASSERT_EQ(*bst.lower_bound_from(BST<int32_t>::const_iterator(), key), key);
+  ASSERT_EQ(*bst.lower_bound_from(bst.end(), key), key);
+  ASSERT_EQ(*bst.insert(BST<int32_t>::iterator(), key), key);
+  ASSERT_EQ(*bst.insert(bst.end(), std::numeric_limits<int32_t>::max()), std::numeric_limits<int32_t>::max());
+  ASSERT_EQ(*bst.insert(bst.find(key), key + 1), key + 1);
+  ASSERT_TRUE(std::is_sorted(bst.begin(), bst.end()));
+}
+
+TEST_F(BstUnitTestSuite, LowerBoundFromTest) {
+  bst.insert(values_unique);
+
+  for (size_t i = 0; i < size; ++i) {
+    auto finger = bst.find(values_unique[i]);
+
+    for (int32_t key : {-1, 0, 2500, 5001, values_unique[(i + 1) % size], values_unique[(i + 1) % size] + 1,
+                        values_unique[i] - 1, values_unique[i] + 1}) {
+      ASSERT_TRUE(bst.lower_bound_from(finger, key) == bst.lower_bound(key));
+    }
+  }
+
+  ASSERT_TRUE(bst.lower_bound_from(bst.end(), 2500) == bst.lower_bound(2500));
+}
+
 TEST_F(BstUnitTestSuite, InsertAndFindTest1) {
 
   for (int32_t& value : values_unique) {
@@ -959,3 +1280,360 @@ TEST_F(BstUnitTestSuite, ClearAndAllocatorTest) {
   ASSERT_EQ(custom_bst.get_allocator().GetAllocationsCount(), custom_bst.get_allocator().GetDeallocationsCount());
   ASSERT_EQ(custom_bst.size(), 0);
 }
+
+TEST_F(BstUnitTestSuite, AggregateTest1) {
+  BST<int64_t, std::less<>, std::allocator<int64_t>, SumAugmentation<int64_t>> sum_bst;
+
+  for (int32_t value : values_unique) {
+    sum_bst.insert(value);
+  }
+
+  std::sort(values_unique.begin(), values_unique.end());
+
+  for (size_t i = 0; i < 100; ++i) {
+    int64_t lo = static_cast<int64_t>(dist(rng) % (distance * size));
+    int64_t hi = lo + static_cast<int64_t>(dist(rng) % (distance * size / 4));
+    int64_t expected = 0;
+
+    for (int32_t value : values_unique) {
+      if (lo <= value && value <= hi) {
+        expected += value;
+      }
+    }
+
+    ASSERT_EQ(sum_bst.aggregate(lo, hi), expected);
+  }
+
+  ASSERT_EQ(sum_bst.aggregate(1, 0), 0);
+}
+
+TEST_F(BstUnitTestSuite, AggregateTest2) {
+  BST<int32_t, std::less<>, std::allocator<int32_t>, MinAugmentation<int32_t>> min_bst;
+  BST<int32_t, std::less<>, std::allocator<int32_t>, MaxAugmentation<int32_t>> max_bst;
+  min_bst.insert(values_unique);
+  max_bst.insert(values_unique);
+  std::vector<int32_t> remaining;
+
+  for (int32_t value : values_unique) {
+    if (dist(rng) % 2 == 0) {
+      min_bst.erase(value);
+      max_bst.erase(value);
+    } else {
+      remaining.push_back(value);
+    }
+  }
+
+  std::sort(remaining.begin(), remaining.end());
+  auto max_value = static_cast<int32_t>(distance * size);
+
+  for (int32_t lo = 0; lo < max_value; lo += 97) {
+    int32_t hi = lo + 500;
+    auto first = std::lower_bound(remaining.begin(), remaining.end(), lo);
+    auto last = std::upper_bound(remaining.begin(), remaining.end(), hi);
+
+    if (first == last) {
+      ASSERT_EQ(min_bst.aggregate(lo, hi), std::numeric_limits<int32_t>::max());
+      ASSERT_EQ(max_bst.aggregate(lo, hi), std::numeric_limits<int32_t>::lowest());
+    } else {
+      ASSERT_EQ(min_bst.aggregate(lo, hi), *first);
+      ASSERT_EQ(max_bst.aggregate(lo, hi), *(last - 1));
+    }
+  }
+}
+
+TEST_F(BstUnitTestSuite, ParallelForEachTest) {
+  BST<int32_t> large;
+
+  for (int32_t i = 0; i < 100000; ++i) {
+    large.insert(values[i % size] * 100000 + i);
+  }
+
+  std::atomic<int64_t> sum = 0;
+  std::atomic<size_t> visited = 0;
+
+  large.parallel_for_each([&](const int32_t& key) {
+    sum.fetch_add(key, std::memory_order_relaxed);
+    visited.fetch_add(1, std::memory_order_relaxed);
+  });
+
+  ASSERT_EQ(visited.load(), large.size());
+  ASSERT_EQ(sum.load(), std::accumulate(large.begin(), large.end(), int64_t{0}));
+}
+
+TEST_F(BstUnitTestSuite, ParallelReduceTest) {
+  BST<std::string> words;
+
+  for (int32_t value : values) {
+    words.insert(std::to_string(value) + ',');
+    bst.insert(value);
+  }
+
+  std::string expected;
+
+  for (const std::string& word : words) {
+    expected += word;
+  }
+
+  ASSERT_EQ(words.parallel_reduce(std::string("|"), std::plus<>()), '|' + expected);
+  ASSERT_EQ(bst.parallel_reduce(int64_t{7}, std::plus<>()), std::accumulate(bst.begin(), bst.end(), int64_t{7}));
+  ASSERT_EQ(BST<int32_t>().parallel_reduce(int64_t{7}, std::plus<>()), 7);
+}
+
+TEST_F(BstUnitTestSuite, ParallelTransformReduceTest) {
+  BST<std::string> words;
+
+  for (int32_t i = 0; i < 150000; ++i) {
+    words.insert(std::string(i % 13 + 1, 'a') + std::to_string(i));
+  }
+
+  auto count_one = [](const std::string&) {
+    return size_t{1};
+  };
+  auto length = [](const std::string& word) {
+    return word.size();
+  };
+  auto max = [](size_t lhs, size_t rhs) {
+    return std::max(lhs, rhs);
+  };
+
+  ASSERT_EQ(words.parallel_transform_reduce(size_t{0}, std::plus<>(), count_one), words.size());
+  ASSERT_EQ(words.parallel_transform_reduce(size_t{0}, max, length), 19);
+  ASSERT_EQ(words.parallel_transform_reduce(size_t{42}, max, length), 42);
+}
+
+TEST_F(BstUnitTestSuite, ThreadedForEachTest) {
+  for (int32_t value : values) {
+    bst.insert(value);
+  }
+
+  std::vector<int32_t> pre_order(bst.begin<PreOrder>(), bst.end<PreOrder>());
+  std::vector<int32_t> in_order;
+
+  ASSERT_TRUE(bst.threaded_for_each([&](int32_t value) {
+    in_order.push_back(value);
+  }));
+  ASSERT_TRUE(std::equal(in_order.begin(), in_order.end(), bst.begin(), bst.end()));
+
+  std::vector<int32_t> prefix;
+
+  ASSERT_FALSE(bst.threaded_for_each([&](int32_t value) {
+    prefix.push_back(value);
+    return prefix.size() < in_order.size() / 2;
+  }));
+  ASSERT_EQ(prefix.size(), in_order.size() / 2);
+  ASSERT_TRUE(std::equal(prefix.begin(), prefix.end(), in_order.begin()));
+  ASSERT_TRUE(std::equal(pre_order.begin(), pre_order.end(), bst.begin<PreOrder>(), bst.end<PreOrder>()));
+  ASSERT_TRUE(std::equal(in_order.rbegin(), in_order.rend(), bst.rbegin(), bst.rend()));
+
+  size_t visited = 0;
+
+  ASSERT_THROW(bst.threaded_for_each([&](int32_t) {
+    if (++visited == in_order.size() / 3) {
+      throw std::runtime_error("stop");
+    }
+  }), std::runtime_error);
+  ASSERT_EQ(visited, in_order.size() / 3);
+  ASSERT_TRUE(std::equal(pre_order.begin(), pre_order.end(), bst.begin<PreOrder>(), bst.end<PreOrder>()));
+  ASSERT_TRUE(std::equal(in_order.rbegin(), in_order.rend(), bst.rbegin(), bst.rend()));
+}
+
+TEST_F(BstUnitTestSuite, SerializeTest1) {
+  for (int32_t value : values) {
+    bst.insert(value);
+  }
+
+  std::stringstream stream;
+  serialize(bst, stream);
+  BST<int32_t> loaded = deserialize<BST<int32_t>>(stream);
+
+  ASSERT_EQ(loaded, bst);
+  ASSERT_EQ(stream.peek(), std::char_traits<char>::eof());
+
+  std::stringstream empty_stream;
+  serialize(BST<int32_t>(), empty_stream);
+  ASSERT_TRUE(deserialize<BST<int32_t>>(empty_stream).empty());
+}
+
+TEST_F(BstUnitTestSuite, SerializeTest2) {
+  BST<std::string> words;
+
+  for (int32_t value : values) {
+    words.insert(std::string(static_cast<size_t>(std::abs(value % 7)), 'x') + std::to_string(value));
+  }
+
+  words.insert(std::string(100000, 'y'));
+  words.insert("");
+  std::stringstream stream;
+  serialize(words, stream);
+
+  ASSERT_EQ(deserialize<BST<std::string>>(stream), words);
+}
+
+TEST_F(BstUnitTestSuite, SerializeAllocatorTest) {
+  using CountingBST = BST<std::string, std::less<>, CountingAllocator<std::string>>;
+  CountingBST words({"a", std::string(100000, 'b'), "c"}, CountingAllocator<std::string>(7));
+
+  for (int32_t value : values) {
+    words.insert(std::to_string(value));
+  }
+
+  std::stringstream stream;
+  serialize(words, stream);
+  CountingBST loaded = deserialize<CountingBST>(stream, std::less<>(), CountingAllocator<std::string>(7));
+
+  ASSERT_TRUE(std::equal(loaded.begin(), loaded.end(), words.begin(), words.end()));
+}
+
+TEST_F(BstUnitTestSuite, SerializeCorruptionTest) {
+  for (int32_t value : values) {
+    bst.insert(value);
+  }
+
+  std::stringstream stream;
+  serialize(bst, stream);
+  std::string image = stream.str();
+  std::string corrupted = image;
+  corrupted[corrupted.size() / 2] ^= 1;
+  std::stringstream corrupted_stream(corrupted);
+  std::stringstream truncated_stream(image.substr(0, image.size() - 1));
+  std::stringstream garbage_stream("not a tree");
+
+  ASSERT_THROW(deserialize<BST<int32_t>>(corrupted_stream), std::runtime_error);
+  ASSERT_THROW(deserialize<BST<int32_t>>(truncated_stream), std::runtime_error);
+  ASSERT_THROW(deserialize<BST<int32_t>>(garbage_stream), std::runtime_error);
+
+  std::stringstream wrong_type_stream(image);
+  ASSERT_THROW(deserialize<BST<int64_t>>(wrong_type_stream), std::runtime_error);
+
+  // The count sits after the magic and three 32-bit header fields.
+  std::string forged = image;
+  forged[16 + 7] = static_cast<char>(0x7f);
+  std::stringstream forged_stream(forged);
+  ASSERT_THROW(deserialize<BST<int32_t>>(forged_stream), std::runtime_error);
+
+  std::string foreign = image;
+  std::reverse(foreign.begin() + 8, foreign.begin() + 12);
+  std::stringstream foreign_stream(foreign);
+  ASSERT_THROW(deserialize<BST<int32_t>>(foreign_stream), std::runtime_error);
+
+  std::string renumbered = image;
+  renumbered[16] ^= 1;
+  std::stringstream renumbered_stream(renumbered);
+  ASSERT_THROW(deserialize<BST<int32_t>>(renumbered_stream), std::runtime_error);
+}
+
+TEST_F(BstUnitTestSuite, SerializeUnseekableTest) {
+  struct PipeBuffer : std::streambuf {
+    explicit PipeBuffer(std::string& data) {
+      setg(data.data(), data.data(), data.data() + data.size());
+    }
+  };
+
+  for (int32_t i = 0; i < 10000; ++i) {
+    bst.insert(i * 3);
+  }
+
+  std::stringstream stream;
+  serialize(bst, stream);
+  std::string image = stream.str();
+  PipeBuffer pipe(image);
+  std::istream pipe_stream(&pipe);
+  ASSERT_EQ(deserialize<BST<int32_t>>(pipe_stream), bst);
+
+  std::string forged = image.substr(0, 64);
+  forged[16 + 7] = static_cast<char>(0x7f);
+  PipeBuffer forged_pipe(forged);
+  std::istream forged_stream(&forged_pipe);
+  ASSERT_THROW(deserialize<BST<int32_t>>(forged_stream), std::runtime_error);
+}
+
+TEST_F(BstUnitTestSuite, IngestTest1) {
+  std::stringstream stream;
+
+  for (int32_t value : values) {
+    stream << ' ' << value << "\r\n\n";
+  }
+
+  BST<int32_t> loaded = from_stream<BST<int32_t>>(stream);
+  BST<int32_t> expected(values.begin(), values.end());
+  ASSERT_EQ(loaded, expected);
+
+  std::stringstream more("1\n2\n3");
+  ingest(loaded, more);
+  expected.insert({1, 2, 3});
+  ASSERT_EQ(loaded, expected);
+
+  std::stringstream malformed("1\n2x\n3\n");
+  ASSERT_THROW(ingest(loaded, malformed), std::runtime_error);
+}
+
+TEST_F(BstUnitTestSuite, IngestTest2) {
+  std::vector<int64_t> keys(200000);
+  std::iota(keys.begin(), keys.end(), -100000);
+  std::stringstream stream;
+  stream.write(reinterpret_cast<const char*>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(int64_t)));
+
+  BST<int64_t> loaded = from_stream<BST<int64_t>>(stream, RecordFormat::kBinary);
+
+  ASSERT_EQ(loaded.size(), keys.size());
+  ASSERT_TRUE(std::equal(loaded.begin(), loaded.end(), keys.begin(), keys.end()));
+
+  std::stringstream truncated(std::string(sizeof(int64_t) + 1, 'x'));
+  ASSERT_THROW(ingest(loaded, truncated, RecordFormat::kBinary), std::runtime_error);
+}
+
+TEST_F(BstUnitTestSuite, IngestTest3) {
+  std::string path = testing::TempDir() + "bst_ingest_words.txt";
+  std::set<std::string> expected;
+
+  {
+    std::ofstream file(path, std::ios::binary);
+
+    for (int32_t value : values) {
+      std::string word = std::string(static_cast<size_t>(std::abs(value % 7)), 'x') + std::to_string(value);
+      file << word << '\n';
+      expected.insert(word);
+    }
+
+    file << std::string(200000, 'y');
+    expected.insert(std::string(200000, 'y'));
+  }
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  BST<std::string> words;
+  ingest(words, fd);
+  ::close(fd);
+  std::remove(path.c_str());
+
+  ASSERT_TRUE(std::equal(words.begin(), words.end(), expected.begin(), expected.end()));
+}
+
+TEST_F(BstUnitTestSuite, IngestTest4) {
+  std::stringstream stream("alpha\r\n\r\n\n two words \r\nbeta\n\ngamma\r");
+  BST<std::string> words = from_stream<BST<std::string>>(stream);
+
+  ASSERT_EQ(words, BST<std::string>({"alpha", " two words ", "beta", "gamma"}));
+}
+
+TEST_F(BstUnitTestSuite, CopyShapeTest) {
+  BST<int64_t, std::less<>, std::allocator<int64_t>, SumAugmentation<int64_t>> chain;
+
+  for (int64_t key = 0; key < 2000; ++key) {
+    chain.insert(key);
+  }
+
+  for (int32_t value : values) {
+    bst.insert(value);
+  }
+
+  auto chain_copy = chain;
+  BST<int32_t> copy;
+  copy = bst;
+
+  ASSERT_TRUE(std::equal(chain_copy.begin<PreOrder>(), chain_copy.end<PreOrder>(),
+                         chain.begin<PreOrder>(), chain.end<PreOrder>()));
+  ASSERT_TRUE(std::equal(copy.begin<PreOrder>(), copy.end<PreOrder>(), bst.begin<PreOrder>(), bst.end<PreOrder>()));
+  ASSERT_EQ(chain_copy.aggregate(0, 1999), 1999 * 2000 / 2);
+  ASSERT_EQ(copy.size(), bst.size());
+}
@@ -1,12 +1,20 @@
+#include <span>
+#include <string_view>
 #include <vector>
 #include <set>
 
 #include "lib/bst/BST.hpp"
+#include "lib/bst/BstSerialization.hpp"
 #include <gtest/gtest.h>
 #include "custom_classes.hpp"
 
 using namespace bialger;
 
+template<typename Tree>
+concept CanSerialize = requires(const Tree& tree, std::ostream& os) {
+  serialize(tree, os);
+};
+
 TEST(ConceptsTestSuite, IsIteratorTest1) {
   bool vector_it_int = InputIterator<std::vector<int32_t>::iterator, int32_t>;
   bool vector_cit_int = InputIterator<std::vector<int32_t>::const_iterator, int32_t>;
@@ -115,3 +123,20 @@ TEST(ConceptsTestSuite, AreComparableTest2) {
   ASSERT_FALSE(string_int64_equals);
   ASSERT_FALSE(int_strings_less_eq);
 }
+
+TEST(ConceptsTestSuite, IsSerializableTest) {
+  bool int_key = Serializable<int32_t>;
+  bool string_key = Serializable<std::string>;
+  bool char_ptr = Serializable<const char*>;
+  bool string_view = Serializable<std::string_view>;
+  bool span = Serializable<std::span<const int32_t>>;
+  bool string_bst = CanSerialize<BST<std::string>>;
+  bool string_view_bst = CanSerialize<BST<std::string_view>>;
+  ASSERT_TRUE(int_key);
+  ASSERT_TRUE(string_key);
+  ASSERT_FALSE(char_ptr);
+  ASSERT_FALSE(string_view);
+  ASSERT_FALSE(span);
+  ASSERT_TRUE(string_bst);
+  ASSERT_FALSE(string_view_bst);
+}
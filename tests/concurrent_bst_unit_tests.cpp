@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/ConcurrentBST.hpp"
+
+using namespace bialger;
+
+TEST(ConcurrentBstTestSuite, SequentialTest) {
+  ConcurrentBST<int32_t> set = {5, 1, 9};
+
+  ASSERT_TRUE(set.insert(3));
+  ASSERT_FALSE(set.insert(5));
+  ASSERT_EQ(set.size(), 4);
+  ASSERT_TRUE(set.contains(9));
+  ASSERT_EQ(set.find(1), 1);
+  ASSERT_EQ(set.find(2), std::nullopt);
+  ASSERT_EQ(set.lower_bound(4), 5);
+  ASSERT_EQ(set.upper_bound(5), 9);
+  ASSERT_EQ(set.upper_bound(9), std::nullopt);
+  ASSERT_EQ(set.erase(1), 1);
+  ASSERT_EQ(set.erase(1), 0);
+  ASSERT_EQ(set.snapshot(), BST<int32_t>({3, 5, 9}));
+
+  set.clear();
+  ASSERT_TRUE(set.empty());
+}
+
+TEST(ConcurrentBstTestSuite, SectionsTest) {
+  ConcurrentBST<int32_t> set;
+
+  size_t inserted = set.write([](BST<int32_t>& bst) {
+    for (int32_t i = 0; i < 100; ++i) {
+      bst.insert(i * 2);
+    }
+
+    return bst.size();
+  });
+
+  int32_t sum = set.read([](const BST<int32_t>& bst) {
+    int32_t result = 0;
+
+    for (int32_t value : bst) {
+      result += value;
+    }
+
+    return result;
+  });
+
+  ASSERT_EQ(inserted, 100);
+  ASSERT_EQ(sum, 9900);
+}
+
+TEST(ConcurrentBstTestSuite, ParallelTest) {
+  const int32_t threads_count = 8;
+  const int32_t per_thread = 2000;
+  ConcurrentBST<int32_t> set;
+  std::vector<std::thread> threads;
+
+  for (int32_t t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&set, t] {
+      for (int32_t i = 0; i < per_thread; ++i) {
+        int32_t key = i * threads_count + t;
+        set.insert(key);
+        ASSERT_EQ(set.contains(key - threads_count), i > 0 && (i - 1) % 2 == 0);
+
+        if (i % 2 == 1) {
+          set.erase(key);
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(set.size(), threads_count * per_thread / 2);
+
+  for (int32_t key = 0; key < threads_count * per_thread; ++key) {
+    ASSERT_EQ(set.contains(key), (key / threads_count) % 2 == 0);
+  }
+}
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/FineGrainedBST.hpp"
+#include "custom_classes.hpp"
+
+using namespace bialger;
+
+TEST(FineGrainedBstTestSuite, SequentialTest) {
+  FineGrainedBST<int32_t, std::less<>, CountingAllocator<int32_t>> set = {50, 30, 70, 20, 40, 60, 80, 35, 45};
+
+  ASSERT_EQ(set.size(), 9);
+  ASSERT_FALSE(set.insert(40));
+  ASSERT_TRUE(set.contains(35));
+  ASSERT_EQ(set.find(45), 45);
+  ASSERT_EQ(set.find(46), std::nullopt);
+  ASSERT_EQ(set.lower_bound(41), 45);
+  ASSERT_EQ(set.upper_bound(45), 50);
+  ASSERT_EQ(set.upper_bound(80), std::nullopt);
+
+  ASSERT_EQ(set.erase(30), 1);
+  ASSERT_EQ(set.erase(50), 1);
+  ASSERT_EQ(set.erase(50), 0);
+  ASSERT_EQ(set.size(), 7);
+
+  std::vector<int32_t> data;
+  set.for_each([&](int32_t value) {
+    data.push_back(value);
+  });
+
+  ASSERT_EQ(data, std::vector<int32_t>({20, 35, 40, 45, 60, 70, 80}));
+  ASSERT_EQ(set.get_allocator().GetDeallocationsCount(), 2);
+
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.get_allocator().GetDeallocationsCount(), 9);
+}
+
+TEST(FineGrainedBstTestSuite, StressTest) {
+  const int32_t threads_count = 8;
+  const int32_t operations = 20000;
+  const int32_t owned_range = 4096;
+  const int32_t shared_base = threads_count * owned_range;
+  FineGrainedBST<int32_t> set;
+  std::vector<std::set<int32_t>> expected(threads_count);
+  std::vector<std::thread> threads;
+
+  for (int32_t t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+
+      for (int32_t i = 0; i < operations; ++i) {
+        int32_t owned = static_cast<int32_t>(rng() % owned_range) * threads_count + t;
+        int32_t shared = shared_base + static_cast<int32_t>(rng() % 64);
+
+        switch (rng() % 4) {
+          case 0:
+            ASSERT_EQ(set.insert(owned), expected[t].insert(owned).second);
+            break;
+          case 1:
+            ASSERT_EQ(set.erase(owned), expected[t].erase(owned));
+            break;
+          case 2:
+            ASSERT_EQ(set.contains(owned), expected[t].contains(owned));
+            break;
+          default:
+            (rng() % 2 == 0) ? set.insert(shared) : set.erase(shared);
+            break;
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int32_t> data;
+  set.for_each([&](int32_t value) {
+    data.push_back(value);
+  });
+
+  std::set<int32_t> owned;
+
+  for (const std::set<int32_t>& thread_set : expected) {
+    owned.insert(thread_set.begin(), thread_set.end());
+  }
+
+  ASSERT_EQ(data.size(), set.size());
+  ASSERT_TRUE(std::adjacent_find(data.begin(), data.end(), std::greater_equal<>()) == data.end());
+  ASSERT_TRUE(std::equal(owned.begin(), owned.end(), data.begin(), data.begin() + owned.size()));
+  ASSERT_TRUE(std::all_of(data.begin() + owned.size(), data.end(), [&](int32_t value) {
+    return value >= shared_base;
+  }));
+}
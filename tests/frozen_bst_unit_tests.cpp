@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/BST.hpp"
+#include "lib/bst/FrozenBstView.hpp"
+#include "custom_classes.hpp"
+#include "test_functions.hpp"
+
+using namespace bialger;
+
+TEST(FrozenBstTestSuite, LookupTest) {
+  std::vector<int32_t> values = GetRandomNumbers(10000);
+  BST<int32_t> bst(values.begin(), values.end());
+  std::string path = testing::TempDir() + "frozen_bst_lookup.bin";
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    freeze(bst, file);
+  }
+
+  FrozenBstView<int32_t> view = FrozenBstView<int32_t>::map(path);
+
+  ASSERT_EQ(view.size(), bst.size());
+  ASSERT_TRUE(view.verify());
+
+  for (int32_t value : values) {
+    for (int32_t key : {value - 1, value, value + 1}) {
+      auto bound = bst.lower_bound(key);
+      auto frozen_bound = view.lower_bound(key);
+      ASSERT_EQ(frozen_bound == view.end(), bound == bst.end());
+
+      if (bound != bst.end()) {
+        ASSERT_EQ(*frozen_bound, *bound);
+      }
+
+      auto upper = bst.upper_bound(key);
+      auto frozen_upper = view.upper_bound(key);
+      ASSERT_EQ(frozen_upper == view.end(), upper == bst.end());
+
+      if (upper != bst.end()) {
+        ASSERT_EQ(*frozen_upper, *upper);
+      }
+
+      ASSERT_EQ(view.contains(key), bst.contains(key));
+    }
+  }
+
+  ASSERT_THROW(*view.find(bst.empty() ? 0 : *bst.rbegin() + 1), std::out_of_range);
+  std::remove(path.c_str());
+}
+
+TEST(FrozenBstTestSuite, IterationTest) {
+  for (int32_t size : {0, 1, 2, 3, 7, 8, 100, 1023, 1024, 1025}) {
+    std::vector<int32_t> values = GetRandomNumbers(size);
+    BST<int32_t> bst(values.begin(), values.end());
+    std::stringstream stream;
+    freeze(bst, stream);
+    std::string image = stream.str();
+    FrozenBstView<int32_t> view(image.data(), image.size());
+
+    ASSERT_EQ(view.empty(), bst.empty());
+    ASSERT_TRUE(std::equal(view.begin(), view.end(), bst.begin(), bst.end()));
+    ASSERT_TRUE(std::equal(view.rbegin(), view.rend(), bst.rbegin(), bst.rend()));
+  }
+}
+
+TEST(FrozenBstTestSuite, AllocatorTest) {
+  using CountingBST = BST<int32_t, std::less<>, CountingAllocator<int32_t>>;
+  CountingBST bst({9, 2, 7, 4}, CountingAllocator<int32_t>(7));
+  std::stringstream stream;
+  freeze(bst, stream);
+  std::string image = stream.str();
+  FrozenBstView<int32_t> view(image.data(), image.size());
+
+  ASSERT_TRUE(view.verify());
+  ASSERT_TRUE(std::equal(view.begin(), view.end(), bst.begin(), bst.end()));
+}
+
+TEST(FrozenBstTestSuite, CorruptionTest) {
+  BST<int32_t> bst = {5, 3, 8, 1, 4};
+  std::stringstream stream;
+  freeze(bst, stream);
+  std::string image = stream.str();
+
+  std::string corrupted = image;
+  corrupted[corrupted.size() - 1] ^= 1;
+  ASSERT_FALSE(FrozenBstView<int32_t>(corrupted.data(), corrupted.size()).verify());
+
+  std::string truncated = image.substr(0, image.size() - 1);
+  std::string garbage(128, 'x');
+  ASSERT_THROW(FrozenBstView<int32_t>(truncated.data(), truncated.size()), std::runtime_error);
+  ASSERT_THROW(FrozenBstView<int32_t>(garbage.data(), garbage.size()), std::runtime_error);
+  ASSERT_THROW(FrozenBstView<int64_t>(image.data(), image.size()), std::runtime_error);
+  ASSERT_THROW(FrozenBstView<int32_t>::map(testing::TempDir() + "missing_frozen_bst.bin"), std::runtime_error);
+}
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "lib/bst/IntervalTree.hpp"
+#include "custom_classes.hpp"
+
+using namespace bialger;
+
+using Interval = std::pair<int64_t, int64_t>;
+
+std::vector<Interval> GetRandomIntervals(size_t n, int64_t max_point, int64_t max_length) {
+  std::vector<Interval> result(n);
+
+  for (Interval& interval : result) {
+    int64_t lo = static_cast<int64_t>(GetRandomNumber() % max_point);
+    interval = {lo, lo + static_cast<int64_t>(GetRandomNumber() % max_length)};
+  }
+
+  return result;
+}
+
+std::vector<Interval> GetOverlappingNaive(const std::vector<Interval>& intervals, int64_t lo, int64_t hi) {
+  std::vector<Interval> result;
+
+  for (const Interval& interval : intervals) {
+    if (interval.first <= hi && lo <= interval.second) {
+      result.push_back(interval);
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+TEST(IntervalTreeTestSuite, EmptyTest) {
+  IntervalTree<int64_t> tree;
+  std::vector<Interval> result;
+  tree.overlapping(0, std::back_inserter(result));
+  ASSERT_TRUE(result.empty());
+  ASSERT_TRUE(tree.empty());
+}
+
+TEST(IntervalTreeTestSuite, BadIntervalTest) {
+  IntervalTree<int64_t> tree;
+  ASSERT_THROW(tree.insert(2, 1), std::invalid_argument);
+  ASSERT_NO_THROW(tree.insert(1, 1));
+  ASSERT_EQ(tree.size(), 1);
+
+  std::vector<Interval> intervals = {{3, 4}, {6, 5}};
+  ASSERT_THROW(tree.insert(Interval(2, 1)), std::invalid_argument);
+  ASSERT_THROW(tree.insert(tree.begin(), Interval(2, 1)), std::invalid_argument);
+  ASSERT_THROW(tree.insert(intervals.begin(), intervals.end()), std::invalid_argument);
+  ASSERT_THROW(tree.insert({{7, 8}, {9, 0}}), std::invalid_argument);
+  ASSERT_THROW(IntervalTree<int64_t>({{1, 2}, {4, 3}}), std::invalid_argument);
+  ASSERT_EQ(tree.size(), 3);
+}
+
+TEST(IntervalTreeTestSuite, PointQueryTest) {
+  IntervalTree<int64_t> tree = {{1, 5}, {3, 4}, {6, 10}, {-2, 0}, {4, 8}};
+  std::vector<Interval> result;
+  tree.overlapping(4, std::back_inserter(result));
+  ASSERT_EQ(result, (std::vector<Interval>{{1, 5}, {3, 4}, {4, 8}}));
+
+  result.clear();
+  tree.overlapping(11, std::back_inserter(result));
+  ASSERT_TRUE(result.empty());
+}
+
+TEST(IntervalTreeTestSuite, RangeQueryTest) {
+  std::vector<Interval> intervals = GetRandomIntervals(1000, 100000, 1000);
+  IntervalTree<int64_t, std::less<>, CountingAllocator<Interval>> tree;
+
+  for (const Interval& interval : intervals) {
+    tree.insert(interval.first, interval.second);
+  }
+
+  for (int64_t lo = 0; lo < 100000; lo += 997) {
+    std::vector<Interval> result;
+    tree.overlapping(lo, lo + 300, std::back_inserter(result));
+    ASSERT_EQ(result, GetOverlappingNaive(intervals, lo, lo + 300));
+  }
+}
+
+TEST(IntervalTreeTestSuite, EraseQueryTest) {
+  std::vector<Interval> intervals = GetRandomIntervals(1000, 10000, 500);
+  std::vector<Interval> remaining;
+  IntervalTree<int64_t> tree;
+  tree.insert(intervals.begin(), intervals.end());
+
+  for (const Interval& interval : intervals) {
+    if (GetRandomNumber() % 2 == 0) {
+      tree.erase(interval);
+    } else {
+      remaining.push_back(interval);
+    }
+  }
+
+  for (const Interval& interval : remaining) {
+    tree.insert(interval);
+  }
+
+  for (int64_t point = 0; point < 10000; point += 37) {
+    std::vector<Interval> result;
+    tree.overlapping(point, std::back_inserter(result));
+    ASSERT_EQ(result, GetOverlappingNaive(remaining, point, point));
+  }
+}
+
+TEST(IntervalTreeTestSuite, ReversedOrderTest) {
+  IntervalTree<int64_t, std::greater<>> tree = {{5, 1}, {10, 7}, {-1, -5}, {3, 3}};
+  std::vector<Interval> result;
+  tree.overlapping(4, 2, std::back_inserter(result));
+  ASSERT_EQ(result, (std::vector<Interval>{{5, 1}, {3, 3}}));
+  ASSERT_THROW(tree.insert(1, 2), std::invalid_argument);
+
+  result.clear();
+  tree.overlapping(-3, std::back_inserter(result));
+  ASSERT_EQ(result, (std::vector<Interval>{{-1, -5}}));
+}
+
+TEST(IntervalTreeTestSuite, StringEndpointsTest) {
+  IntervalTree<std::string> tree = {{"apple", "banana"}, {"cherry", "grape"}, {"kiwi", "lemon"}};
+  std::vector<std::pair<std::string, std::string>> result;
+  tree.overlapping("fig", std::back_inserter(result));
+  ASSERT_EQ(result.size(), 1);
+  ASSERT_EQ(result[0].first, "cherry");
+  ASSERT_FALSE(tree.insert("kiwi", "lemon").second);
+  ASSERT_EQ(tree.size(), 3);
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/PersistentBST.hpp"
+#include "custom_classes.hpp"
+
+using namespace bialger;
+
+TEST(PersistentBstTestSuite, BasicTest) {
+  PersistentBST<int32_t> set = {5, 3, 8, 1, 4};
+
+  ASSERT_EQ(set.size(), 5);
+  ASSERT_FALSE(set.insert(4).second);
+  ASSERT_EQ(*set.insert(6).first, 6);
+  ASSERT_TRUE(set.contains(6));
+  ASSERT_EQ(*set.lower_bound(7), 8);
+  ASSERT_TRUE(set.upper_bound(8) == set.end());
+  ASSERT_EQ(*set.erase(set.find(5)), 6);
+  ASSERT_EQ(set.erase(5), 0);
+
+  std::vector<int32_t> data(set.begin(), set.end());
+  std::vector<int32_t> reversed(set.rbegin(), set.rend());
+  ASSERT_EQ(data, std::vector<int32_t>({1, 3, 4, 6, 8}));
+  ASSERT_EQ(reversed, std::vector<int32_t>({8, 6, 4, 3, 1}));
+}
+
+TEST(PersistentBstTestSuite, SnapshotTest) {
+  std::vector<int32_t> values = GetRandomNumbers(1000);
+  PersistentBST<int32_t> set(values.begin(), values.end());
+  std::set<int32_t> expected(values.begin(), values.end());
+  std::vector<PersistentBST<int32_t>> versions;
+
+  for (size_t i = 0; i < values.size(); i += 10) {
+    versions.push_back(set.snapshot());
+    set.erase(values[i]);
+    set.insert(values[i] + 1000000);
+  }
+
+  for (size_t v = 0; v < versions.size(); ++v) {
+    std::set<int32_t> version_expected = expected;
+
+    for (size_t i = 0; i < v * 10; i += 10) {
+      version_expected.erase(values[i]);
+      version_expected.insert(values[i] + 1000000);
+    }
+
+    ASSERT_EQ(versions[v].size(), version_expected.size());
+    ASSERT_TRUE(std::equal(versions[v].begin(), versions[v].end(), version_expected.begin(), version_expected.end()));
+  }
+}
+
+TEST(PersistentBstTestSuite, PathCopyTest) {
+  PersistentBST<int32_t, std::less<>, CountingAllocator<int32_t>> set;
+
+  for (int32_t i = 0; i < 100000; ++i) {
+    set.insert(i);
+  }
+
+  PersistentBST<int32_t, std::less<>, CountingAllocator<int32_t>> snapshot = set.snapshot();
+  size_t allocations = set.get_allocator().GetAllocationsCount();
+
+  set.insert(-1);
+  set.erase(50000);
+
+  ASSERT_LE(set.get_allocator().GetAllocationsCount() - allocations, 60);
+  ASSERT_EQ(snapshot.size(), 100000);
+  ASSERT_TRUE(snapshot.contains(50000));
+  ASSERT_FALSE(snapshot.contains(-1));
+  ASSERT_FALSE(set.contains(50000));
+  ASSERT_EQ(*set.begin(), -1);
+  ASSERT_FALSE(snapshot == set);
+}
+
+TEST(PersistentBstTestSuite, ReleaseTest) {
+  PersistentBST<int32_t, std::less<>, CountingAllocator<int32_t>> set;
+
+  for (int32_t i = 0; i < 1000; ++i) {
+    set.insert(i * 7 % 1000);
+  }
+
+  for (int32_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(set.erase(i), 1);
+  }
+
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.get_allocator().GetAllocationsCount(), set.get_allocator().GetDeallocationsCount());
+}
+
+TEST(PersistentBstTestSuite, CopyOnWriteTest) {
+  PersistentBST<int32_t, std::less<>, CountingAllocator<int32_t>> set;
+
+  for (int32_t i = 0; i < 100000; ++i) {
+    set.insert(i);
+  }
+
+  size_t allocations = set.get_allocator().GetAllocationsCount();
+
+  for (int32_t i = 0; i < 1000; ++i) {
+    set.erase(i * 100);
+  }
+
+  set.insert(-1);
+  ASSERT_EQ(set.get_allocator().GetAllocationsCount() - allocations, 1);
+
+  PersistentBST<int32_t, std::less<>, CountingAllocator<int32_t>> copy = set;
+  allocations = copy.get_allocator().GetAllocationsCount();
+  copy.insert(-2);
+  size_t first_write = copy.get_allocator().GetAllocationsCount() - allocations;
+  copy.insert(-3);
+  size_t second_write = copy.get_allocator().GetAllocationsCount() - allocations - first_write;
+
+  ASSERT_GT(first_write, 1);
+  ASSERT_LT(second_write, first_write);
+  ASSERT_EQ(set.size(), 99001);
+  ASSERT_EQ(copy.size(), 99003);
+  ASSERT_EQ(*set.begin(), -1);
+  ASSERT_EQ(*copy.begin(), -3);
+  ASSERT_TRUE(std::is_sorted(copy.begin(), copy.end()));
+  ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+}
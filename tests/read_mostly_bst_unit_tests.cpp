@@ -0,0 +1,89 @@
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/ReadMostlyBST.hpp"
+#include "custom_classes.hpp"
+
+using namespace bialger;
+
+TEST(ReadMostlyBstTestSuite, SequentialTest) {
+  ReadMostlyBST<int32_t, std::less<>, CountingAllocator<int32_t>> set = {50, 30, 70, 20, 40, 60, 80, 35, 45};
+
+  ASSERT_EQ(set.size(), 9);
+  ASSERT_FALSE(set.insert(40));
+  ASSERT_EQ(set.find(45), 45);
+  ASSERT_EQ(set.find(46), std::nullopt);
+  ASSERT_EQ(set.lower_bound(41), 45);
+  ASSERT_EQ(set.upper_bound(45), 50);
+
+  ASSERT_EQ(set.erase(30), 1);
+  ASSERT_EQ(set.erase(50), 1);
+  ASSERT_EQ(set.erase(50), 0);
+  ASSERT_EQ(set.size(), 7);
+
+  std::vector<int32_t> data;
+  set.for_each([&](int32_t value) {
+    data.push_back(value);
+  });
+
+  ASSERT_EQ(data, std::vector<int32_t>({20, 35, 40, 45, 60, 70, 80}));
+
+  set.clear();
+  set.reclaim();
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.get_allocator().GetAllocationsCount(), set.get_allocator().GetDeallocationsCount());
+}
+
+TEST(ReadMostlyBstTestSuite, ReadersDuringWritesTest) {
+  const int32_t stable_count = 1000;
+  const int32_t readers_count = 4;
+  ReadMostlyBST<int32_t, std::less<>, CountingAllocator<int32_t>> set;
+  std::atomic<bool> done = false;
+  std::atomic<size_t> failures = 0;
+  std::vector<std::thread> readers;
+
+  for (int32_t i = 0; i < stable_count; ++i) {
+    set.insert(i * 2);
+  }
+
+  for (int32_t r = 0; r < readers_count; ++r) {
+    readers.emplace_back([&, r] {
+      std::mt19937 rng(r);
+
+      while (!done.load()) {
+        int32_t key = static_cast<int32_t>(rng() % stable_count) * 2;
+
+        if (!set.contains(key) || set.upper_bound(key - 1) != key) {
+          ++failures;
+        }
+      }
+    });
+  }
+
+  std::mt19937 rng(42);
+
+  for (int32_t i = 0; i < 50000; ++i) {
+    int32_t key = static_cast<int32_t>(rng() % stable_count) * 2 + 1;
+    (rng() % 2 == 0) ? set.insert(key) : set.erase(key);
+  }
+
+  done = true;
+
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(failures, 0);
+
+  for (int32_t i = 0; i < stable_count; ++i) {
+    ASSERT_EQ(set.erase(i * 2), 1);
+  }
+
+  set.clear();
+  set.reclaim();
+  ASSERT_EQ(set.get_allocator().GetAllocationsCount(), set.get_allocator().GetDeallocationsCount());
+}
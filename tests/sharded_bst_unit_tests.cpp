@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lib/bst/ShardedBST.hpp"
+
+using namespace bialger;
+
+TEST(ShardedBstTestSuite, SequentialTest) {
+  ShardedBST<int32_t> set = {5, 1, 9};
+
+  ASSERT_TRUE(set.insert(3));
+  ASSERT_FALSE(set.insert(5));
+  ASSERT_EQ(set.size(), 4);
+  ASSERT_TRUE(set.contains(9));
+  ASSERT_EQ(set.find(1), 1);
+  ASSERT_EQ(set.find(2), std::nullopt);
+  ASSERT_EQ(set.lower_bound(4), 5);
+  ASSERT_EQ(set.upper_bound(5), 9);
+  ASSERT_EQ(set.upper_bound(9), std::nullopt);
+  ASSERT_EQ(set.erase(1), 1);
+  ASSERT_EQ(set.erase(1), 0);
+  ASSERT_EQ(set.snapshot(), BST<int32_t>({3, 5, 9}));
+
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_THROW(ShardedBST<int32_t>(0), std::invalid_argument);
+}
+
+TEST(ShardedBstTestSuite, RebalanceTest) {
+  ShardedBST<int32_t> set(8);
+  const int32_t count = 100000;
+  std::vector<int32_t> values(count);
+
+  for (int32_t i = 0; i < count; ++i) {
+    values[i] = i * 2;
+  }
+
+  std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+  for (int32_t value : values) {
+    set.insert(value);
+  }
+
+  for (size_t i = 0; i < set.shard_count(); ++i) {
+    ASSERT_LE(set.shard_size(i), 2 * count / set.shard_count() + 1024);
+  }
+
+  std::vector<int32_t> keys;
+  set.for_each([&](int32_t key) {
+    keys.push_back(key);
+  });
+
+  ASSERT_EQ(keys.size(), count);
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+  for (int32_t i = 0; i < count; i += 97) {
+    ASSERT_EQ(set.lower_bound(i * 2 - 1), i * 2);
+    ASSERT_EQ(set.upper_bound(i * 2), (i + 1 < count) ? std::optional<int32_t>(i * 2 + 2) : std::nullopt);
+  }
+
+  set.rebalance();
+
+  for (size_t i = 0; i < set.shard_count(); ++i) {
+    ASSERT_EQ(set.shard_size(i), count / set.shard_count());
+  }
+
+  ASSERT_EQ(set.size(), count);
+  ASSERT_EQ(set.snapshot().size(), count);
+}
+
+TEST(ShardedBstTestSuite, ParallelTest) {
+  const int32_t threads_count = 8;
+  const int32_t per_thread = 5000;
+  ShardedBST<int32_t> set(4);
+  std::vector<std::thread> threads;
+
+  for (int32_t t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&set, t] {
+      for (int32_t i = 0; i < per_thread; ++i) {
+        int32_t key = t * per_thread + i * 7919 % per_thread;
+        set.insert(key);
+        ASSERT_TRUE(set.contains(key));
+
+        if (key % 2 == 1) {
+          set.erase(key);
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(set.size(), threads_count * per_thread / 2);
+
+  for (int32_t key = 0; key < threads_count * per_thread; ++key) {
+    ASSERT_EQ(set.contains(key), key % 2 == 0);
+  }
+}
+
+TEST(ShardedBstTestSuite, ConcurrentRebalanceTest) {
+  const int32_t writers_count = 4;
+  const int32_t per_thread = 5000;
+  ShardedBST<int32_t> set(8);
+  std::atomic<bool> done = false;
+  std::vector<std::thread> writers;
+
+  std::thread rebalancer([&] {
+    while (!done.load()) {
+      set.rebalance();
+      std::optional<int32_t> bound = set.lower_bound(per_thread);
+      ASSERT_TRUE(!bound.has_value() || *bound >= per_thread);
+    }
+  });
+
+  for (int32_t t = 0; t < writers_count; ++t) {
+    writers.emplace_back([&set, t] {
+      for (int32_t i = 0; i < per_thread; ++i) {
+        int32_t key = i * writers_count + t;
+        ASSERT_TRUE(set.insert(key));
+        ASSERT_EQ(set.find(key), key);
+      }
+    });
+  }
+
+  for (std::thread& thread : writers) {
+    thread.join();
+  }
+
+  done.store(true);
+  rebalancer.join();
+
+  std::vector<int32_t> keys;
+  set.for_each([&](int32_t key) {
+    keys.push_back(key);
+  });
+
+  ASSERT_EQ(set.size(), writers_count * per_thread);
+  ASSERT_EQ(keys.size(), set.size());
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  ASSERT_EQ(set.lower_bound(-1), 0);
+}
+
+TEST(ShardedBstTestSuite, MutatingForEachTest) {
+  ShardedBST<int32_t> set(4);
+
+  for (int32_t i = 0; i < 10000; ++i) {
+    set.insert(i);
+  }
+
+  std::vector<int32_t> keys;
+  set.for_each([&](int32_t key) {
+    keys.push_back(key);
+
+    if (key < 100000) {
+      set.insert(key + 100000);
+    }
+  });
+
+  ASSERT_EQ(set.size(), 20000);
+  ASSERT_GE(keys.size(), 10000);
+  ASSERT_TRUE(std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<>()) == keys.end());
+  ASSERT_EQ(keys[9999], 9999);
+}
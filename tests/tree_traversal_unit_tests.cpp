@@ -244,3 +244,28 @@ TEST_F(TreeTraversalUnitTestSuite, PostOrderFullTraverseTreeTest) {
 
   std::reverse(real_traverse.begin(), real_traverse.end());
 }
+
+TEST_F(TreeTraversalUnitTestSuite, EarlyExitTraverseTreeTest) {
+  for (int32_t& value : values) {
+    bst.Insert(value, &value);
+  }
+
+  bst.Traverse<InOrder>(push_node);
+  size_t limit = real_traverse.size() / 3;
+
+  for (size_t i = 0; i < limit; ++i) {
+    class_traverse.push_back(real_traverse[i]);
+  }
+
+  real_traverse.clear();
+  bool completed = bst.Traverse<InOrder>([&](const IntTree::NodeType* node) {
+    real_traverse.push_back(node->key);
+    return real_traverse.size() < limit;
+  });
+
+  ASSERT_FALSE(completed);
+  ASSERT_EQ(real_traverse, class_traverse);
+  ASSERT_TRUE(bst.Traverse<PostOrder>([](const IntTree::NodeType*) {
+    return true;
+  }));
+}
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -6,6 +7,7 @@
 
 #include "test_functions.hpp"
 #include "TreeUnitTestSuite.hpp"
+#include "custom_classes.hpp"
 
 using namespace bialger;
 
@@ -257,6 +259,25 @@ TEST_F(TreeUnitTestSuite, DeleteTreeTest6) {
   ASSERT_EQ(bst_dupl.GetSize(), 0);
 }
 
+TEST_F(TreeUnitTestSuite, DeleteKeyTreeTest1) {
+  std::vector<int32_t> values(values_random);
+
+  for (int32_t& value : values) {
+    bst.Insert(value, &value);
+  }
+
+  std::shuffle(values.begin(), values.end(), rng);
+
+  for (int32_t& value : values) {
+    bool was_present = bst.Contains(value);
+    ASSERT_EQ(bst.DeleteKey(value), was_present);
+    ASSERT_FALSE(bst.Contains(value));
+  }
+
+  ASSERT_EQ(bst.GetRoot(), nullptr);
+  ASSERT_EQ(bst.GetSize(), 0);
+}
+
 TEST_F(TreeUnitTestSuite, FindNextTreeTest1) {
   std::vector<int32_t> values(values_unique);
 
@@ -513,3 +534,190 @@ TEST_F(TreeUnitTestSuite, FindNextUnstrictTreeTest2) {
     }
   }
 }
+
+TEST_F(TreeUnitTestSuite, BuildFromTreeTest) {
+  std::vector<int32_t> values(100000);
+
+  for (int32_t i = 0; i < static_cast<int32_t>(values.size()); ++i) {
+    values[i] = i / 2;
+  }
+
+  std::shuffle(values.begin(), values.end(), rng);
+  IntTree sequential;
+  IntTree parallel;
+  sequential.BuildFrom(values.begin(), values.end(), 1);
+  parallel.BuildFrom(values.begin(), values.end(), 8);
+  std::vector<int32_t> sequential_keys;
+  std::vector<int32_t> parallel_keys;
+
+  sequential.Traverse<PreOrder>([&](const IntTree::NodeType* node) {
+    sequential_keys.push_back(node->key);
+  });
+  parallel.Traverse<PreOrder>([&](const IntTree::NodeType* node) {
+    parallel_keys.push_back(node->key);
+  });
+
+  ASSERT_EQ(sequential.GetSize(), values.size() / 2);
+  ASSERT_EQ(parallel.GetSize(), values.size() / 2);
+  ASSERT_EQ(sequential_keys, parallel_keys);
+}
+
+TEST_F(TreeUnitTestSuite, ParallelReduceTreeTest) {
+  std::vector<int32_t> values(200000);
+
+  for (int32_t i = 0; i < static_cast<int32_t>(values.size()); ++i) {
+    values[i] = i;
+  }
+
+  // The largest key goes in first, so the root has no right subtree.
+  std::shuffle(values.begin(), values.end() - 1, rng);
+  std::rotate(values.begin(), values.end() - 1, values.end());
+
+  for (int32_t& value : values) {
+    bst.Insert(value, &value);
+  }
+
+  std::atomic<int64_t> sum = 0;
+
+  bst.ParallelForEach([&](const IntTree::NodeType* node) {
+    sum.fetch_add(node->key, std::memory_order_relaxed);
+  }, 8);
+
+  auto keep_last = [](int64_t, int64_t rhs) {
+    return rhs;
+  };
+  auto check_order = [](int64_t lhs, int64_t rhs) {
+    return (lhs < rhs) ? rhs : std::numeric_limits<int32_t>::max();
+  };
+  auto count_one = [](int32_t) {
+    return size_t{1};
+  };
+
+  ASSERT_EQ(sum.load(), int64_t{199999} * 200000 / 2);
+  ASSERT_EQ(bst.ParallelReduce(int64_t{0}, std::plus<>(), std::identity(), 8), int64_t{199999} * 200000 / 2);
+  ASSERT_EQ(bst.ParallelReduce(int64_t{-1}, keep_last, std::identity(), 8), 199999);
+  ASSERT_EQ(bst.ParallelReduce(int64_t{-1}, check_order, std::identity(), 8), 199999);
+  ASSERT_EQ(bst.ParallelReduce(size_t{0}, std::plus<>(), count_one, 8), values.size());
+}
+
+struct TrackedKey {
+  static inline int32_t live = 0;
+  static inline int32_t copies_left = 0;
+
+  int32_t value;
+
+  explicit TrackedKey(int32_t value) : value(value) {
+    ++live;
+  }
+
+  TrackedKey(const TrackedKey& other) : value(other.value) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("TrackedKey copy failed");
+    }
+
+    ++live;
+  }
+
+  ~TrackedKey() {
+    --live;
+  }
+
+  bool operator<(const TrackedKey& other) const {
+    return value < other.value;
+  }
+
+  bool operator==(const TrackedKey& other) const {
+    return value == other.value;
+  }
+};
+
+TEST_F(TreeUnitTestSuite, BuildFromThrowTreeTest) {
+  using TrackedTree = BinarySearchTree<TrackedKey, EmptyValue, std::less<>, std::allocator<TrackedKey>>;
+  std::vector<TrackedKey> keys;
+  keys.reserve(100);
+
+  for (int32_t i = 0; i < 100; ++i) {
+    keys.emplace_back(i);
+  }
+
+  {
+    TrackedTree tree;
+    TrackedKey::copies_left = 50;
+    ASSERT_THROW(tree.BuildFrom(keys.begin(), keys.end()), std::runtime_error);
+    ASSERT_EQ(tree.GetSize(), 0);
+    ASSERT_EQ(TrackedKey::live, 100);
+
+    TrackedKey::copies_left = std::numeric_limits<int32_t>::max();
+    tree.BuildFrom(keys.begin(), keys.end());
+    ASSERT_EQ(tree.GetSize(), 100);
+  }
+
+  ASSERT_EQ(TrackedKey::live, 100);
+}
+
+TEST_F(TreeUnitTestSuite, MergeThrowTreeTest) {
+  using TrackedTree = BinarySearchTree<TrackedKey, EmptyValue, std::less<>, CountingAllocator<TrackedKey>>;
+  TrackedKey::copies_left = std::numeric_limits<int32_t>::max();
+
+  {
+    TrackedTree lhs(false, std::less<>(), CountingAllocator<TrackedKey>(1));
+    TrackedTree rhs(false, std::less<>(), CountingAllocator<TrackedKey>(2));
+
+    for (int32_t i = 0; i < 20; ++i) {
+      lhs.TryEmplace(TrackedKey(i * 3));
+      rhs.TryEmplace(TrackedKey(i * 2));
+    }
+
+    TrackedKey::copies_left = 10;
+    ASSERT_THROW(lhs.Merge(rhs), std::runtime_error);
+    TrackedKey::copies_left = std::numeric_limits<int32_t>::max();
+
+    size_t visited = 0;
+    int32_t last = -1;
+
+    rhs.Traverse<InOrder>([&](const TrackedTree::NodeType* node) {
+      ASSERT_LT(last, node->key.value);
+      last = node->key.value;
+      ++visited;
+    });
+
+    ASSERT_EQ(visited, rhs.GetSize());
+    ASSERT_EQ(lhs.GetSize() + rhs.GetSize(), 40);
+    ASSERT_EQ(TrackedKey::live, 40);
+
+    lhs.Merge(rhs);
+    ASSERT_EQ(lhs.GetSize(), 33);
+    ASSERT_EQ(rhs.GetSize(), 7);
+  }
+
+  ASSERT_EQ(TrackedKey::live, 0);
+}
+
+TEST_F(TreeUnitTestSuite, SetOperationThrowTreeTest) {
+  using TrackedTree = BinarySearchTree<TrackedKey, EmptyValue, std::less<>, std::allocator<TrackedKey>>;
+  TrackedKey::copies_left = std::numeric_limits<int32_t>::max();
+
+  {
+    TrackedTree lhs;
+    TrackedTree rhs;
+    TrackedTree result;
+
+    for (int32_t i = 0; i < 20; ++i) {
+      lhs.TryEmplace(TrackedKey(i));
+      rhs.TryEmplace(TrackedKey(i + 10));
+      result.TryEmplace(TrackedKey(-i));
+    }
+
+    TrackedKey::copies_left = 15;
+    ASSERT_THROW(result.AssignSetOperation(lhs, rhs, true, true, true), std::runtime_error);
+    TrackedKey::copies_left = std::numeric_limits<int32_t>::max();
+
+    ASSERT_EQ(result.GetSize(), 20);
+    ASSERT_EQ(TrackedKey::live, 60);
+
+    result.AssignSetOperation(lhs, rhs, true, true, true);
+    ASSERT_EQ(result.GetSize(), 30);
+  }
+
+  ASSERT_EQ(TrackedKey::live, 0);
+}